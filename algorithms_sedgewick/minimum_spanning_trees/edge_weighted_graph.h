@@ -0,0 +1,120 @@
+#ifndef __EDGE_WEIGHTED_GRAPH_H__
+#define __EDGE_WEIGHTED_GRAPH_H__
+
+#include <iostream>
+#include <vector>
+#include <limits>
+#include <stdexcept>
+#include <cstdint>
+#include <cassert>
+#include <utility>
+
+//Edge weighted graph, stored as the list of its edges...
+
+/*
+
+The spanning tree algorithms only look at the edges one by one (sorted, filtered, or scanned for the
+lightest edge leaving a component), so a flat array of (v, w, weight) is all they need.
+
+Ties: two edges are compared by (weight, index in the list). With that total order the minimum spanning
+forest is unique, so the edge sets found by different algorithms can be compared exactly.
+
+*/
+
+struct weighted_edge_t{
+    uint64_t v;
+    uint64_t w;
+    double weight;
+
+    //the other end of the edge
+    uint64_t other(uint64_t x)const{
+        assert(x == v || x == w);
+        return x == v ? w : v;
+    }
+};
+
+struct edge_weighted_graph_t{
+    //no edge / no vertex (scoped, ../undirected_graphs/graph.h has its own global infinity)
+    static constexpr uint64_t infinity = std::numeric_limits<uint64_t>::max();
+
+    edge_weighted_graph_t() = default;
+
+    //a graph with n vertices from a list of edges (e.g. a generated one)
+    edge_weighted_graph_t(uint64_t n, std::vector<weighted_edge_t> es) : n{n}, es(std::move(es)), valid{true}{
+        for(auto& e : this->es)
+            assert(e.v < n && e.w < n);
+    }
+
+    bool is_valid() const {return valid;}
+
+    //number or vertices
+    uint64_t vertices()const{
+        assert(valid);
+        return n;
+    }
+
+    //number of edges
+    uint64_t edges()const{
+        assert(valid);
+        return es.size();
+    }
+
+    weighted_edge_t const& edge(uint64_t i)const{
+        assert(valid);
+        assert(i < es.size());
+        return es[i];
+    }
+
+    //is the edge i lighter than the edge j? (ties broken by the index)
+    bool lighter(uint64_t i, uint64_t j)const{
+        return es[i].weight < es[j].weight || (es[i].weight == es[j].weight && i < j);
+    }
+
+private:
+    friend std::istream& operator>>(std::istream& is, edge_weighted_graph_t& g);
+
+    uint64_t n{0};
+    std::vector<weighted_edge_t> es;
+    bool valid{false};
+};
+
+constexpr uint64_t edge_weighted_graph_t::infinity;
+
+//display the graph
+std::ostream& operator<<(std::ostream& os, edge_weighted_graph_t const& g){
+    assert(g.is_valid());
+
+    os  << "Number of vertices: " << g.vertices() << std::endl
+        << "Number of edges: " << g.edges() << std::endl;
+    for(uint64_t i=0; i < g.edges(); ++i){
+        auto& e = g.edge(i);
+        os << e.v << "-" << e.w << " " << e.weight << std::endl;
+    }
+    return os;
+}
+
+//read the graph from a stream (from Sedgewick's datasets: V, E, then "v w weight" per edge)
+std::istream& operator>>(std::istream& is, edge_weighted_graph_t& g){
+    assert(!g.is_valid());
+
+    uint64_t e{0};
+    is >> g.n >> e;
+
+    g.es.reserve(e);
+    weighted_edge_t edge;
+    while(g.es.size() < e && is >> edge.v >> edge.w >> edge.weight){
+        if(edge.v >= g.n || edge.w >= g.n)
+            break;
+        g.es.push_back(edge);
+    }
+
+    if(g.es.size() != e){
+        is.setstate(std::ios::failbit);
+        throw std::runtime_error("Error reading the graph");
+    }
+
+    g.valid = true;
+    return is;
+}
+
+#endif//__EDGE_WEIGHTED_GRAPH_H__
@@ -0,0 +1,223 @@
+#ifndef __MSF_H__
+#define __MSF_H__
+
+#include "edge_weighted_graph.h"
+#include "../undirected_graphs/parallel.h"
+#include "../union_find/uf_impl.h"
+#include "../union_find/uf_concurrent.h"
+
+#include <algorithm>
+#include <memory>
+#include <random>
+
+//Minimum spanning forest (a minimum spanning tree for every connected component)...
+
+/*
+
+cut property: the lightest edge crossing any cut is in the minimum spanning forest, all three
+algorithms are different ways of picking such edges
+
+Kruskal             all the edges sorted by weight (parallel sort), an edge is taken if its ends are
+                    not connected yet (weighted quick union with path compression)
+                    E log E
+filter-Kruskal      quicksort-like: split the edges around a random pivot, solve the light half, drop
+                    the heavy edges whose ends got connected, then solve what is left of the heavy half
+                    (the heavy edges that can't be in the forest are never sorted)
+                    E + V log V log (E/V) expected on random graphs
+Boruvka             in every round every component picks its lightest outgoing edge and all of them are
+                    added at once (a concurrent union-find, the edges are scanned in parallel), the number
+                    of components at least halves => log V rounds
+                    E log V
+
+*/
+
+struct msf_t{
+    msf_t(edge_weighted_graph_t const& g) : g{g}{assert(g.is_valid());}
+
+    //just to force this type to be only base class
+    virtual ~msf_t() = 0;
+
+    //indices (in the graph) of the edges of the forest, sorted
+    std::vector<uint64_t> const& edges()const{return es;}
+
+    //total weight of the forest
+    double weight()const{return total;}
+
+    //number of trees (= connected components of the graph)
+    uint64_t trees()const{return g.vertices() - es.size();}
+
+protected:
+    //puts the edges in a canonical order (so that the algorithms can be compared)
+    void finish(){
+        std::sort(es.begin(), es.end());
+        total = 0;
+        for(auto i : es)
+            total += g.edge(i).weight;
+    }
+
+    //(weight, index): sorting these pairs is sorting by the tie-breaking order of the graph
+    using key_t = std::pair<double, uint64_t>;
+
+    std::vector<key_t> keys()const{
+        std::vector<key_t> ks(g.edges());
+        for(uint64_t i=0; i<g.edges(); ++i)
+            ks[i] = key_t{g.edge(i).weight, i};
+        return ks;
+    }
+
+    edge_weighted_graph_t const& g;
+    std::vector<uint64_t> es;
+    double total{0};
+};
+
+msf_t::~msf_t(){};
+
+struct kruskal_msf_t : public msf_t{
+    kruskal_msf_t(edge_weighted_graph_t const& g, uint64_t nthreads = 0) : msf_t(g){
+        auto ks = keys();
+        parallel::sort(ks.begin(), ks.end(), std::less<key_t>{}, parallel::threads(nthreads));
+
+        union_find_weighted_quick_union_path_compression uf{g.vertices()};
+        for(auto& k : ks){
+            //a spanning tree is complete
+            if(uf.count() == 1) break;
+            auto& e = g.edge(k.second);
+            if(!uf.connected(e.v, e.w)){
+                uf.connect(e.v, e.w);
+                es.push_back(k.second);
+            }
+        }
+        finish();
+    }
+};
+
+struct filter_kruskal_msf_t : public msf_t{
+    filter_kruskal_msf_t(edge_weighted_graph_t const& g, uint64_t nthreads = 0)
+        : msf_t(g), nthreads{parallel::threads(nthreads)}, uf{g.vertices()}
+    {
+        auto ks = keys();
+        threshold = std::max<uint64_t>(1024, g.vertices());
+        filter_kruskal(ks.begin(), ks.end());
+        finish();
+    }
+
+private:
+    using iterator = std::vector<key_t>::iterator;
+
+    void filter_kruskal(iterator first, iterator last){
+        if(uint64_t(last - first) <= threshold){
+            parallel::sort(first, last, std::less<key_t>{}, nthreads);
+            kruskal(first, last);
+            return;
+        }
+        //pivot: median of 3 random edges
+        std::uniform_int_distribution<uint64_t> pick{0, uint64_t(last - first) - 1};
+        key_t p[3] = {first[pick(gen)], first[pick(gen)], first[pick(gen)]};
+        std::sort(p, p+3);
+        auto pivot = p[1];
+
+        auto middle = std::partition(first, last, [&pivot](key_t const& k){return k < pivot;});
+        filter_kruskal(first, middle);
+        //the heavy edges inside a component are not needed anymore
+        last = std::remove_if(middle, last, [this](key_t const& k){
+            auto& e = g.edge(k.second);
+            return uf.connected(e.v, e.w);
+        });
+        filter_kruskal(middle, last);
+    }
+
+    void kruskal(iterator first, iterator last){
+        for(auto it=first; it!=last; ++it){
+            auto& e = g.edge(it->second);
+            if(!uf.connected(e.v, e.w)){
+                uf.connect(e.v, e.w);
+                es.push_back(it->second);
+            }
+        }
+    }
+
+    uint64_t nthreads;
+    uint64_t threshold;
+    union_find_weighted_quick_union_path_compression uf;
+    std::mt19937_64 gen{42};
+};
+
+struct boruvka_msf_t : public msf_t{
+    boruvka_msf_t(edge_weighted_graph_t const& g, uint64_t nthreads = 0) : msf_t(g), nthreads{parallel::threads(nthreads)}{
+        uint64_t n{g.vertices()};
+        union_find_concurrent uf{n};
+        //lightest edge leaving each component (indexed by its root)
+        auto best = std::make_unique<std::atomic<uint64_t>[]>(n);
+        for(uint64_t v=0; v<n; ++v)
+            best[v].store(edge_weighted_graph_t::infinity, std::memory_order_relaxed);
+
+        //the edges that can still be in the forest (no self loops)
+        std::vector<uint64_t> active;
+        for(uint64_t i=0; i<g.edges(); ++i)
+            if(g.edge(i).v != g.edge(i).w) active.push_back(i);
+
+        //the root of every vertex, refreshed once per round (plain loads while scanning the edges)
+        std::vector<uint64_t> comp(n);
+        std::vector<std::vector<uint64_t>> local(this->nthreads);
+        while(true){
+            parallel::for_chunks(n, this->nthreads, [&](uint64_t lo, uint64_t hi, uint64_t){
+                for(auto v=lo; v<hi; ++v)
+                    comp[v] = uf.find(v);
+            });
+
+            //drop the edges inside a component, the others are candidates for their two components
+            parallel::for_chunks(active.size(), this->nthreads, [&](uint64_t lo, uint64_t hi, uint64_t t){
+                for(auto i=lo; i<hi; ++i){
+                    auto& e = g.edge(active[i]);
+                    auto rv = comp[e.v], rw = comp[e.w];
+                    if(rv == rw) continue;
+                    local[t].push_back(active[i]);
+                    lightest(best[rv], active[i]);
+                    lightest(best[rw], active[i]);
+                }
+            });
+            active.clear();
+            for(auto& l : local){
+                active.insert(active.end(), l.begin(), l.end());
+                l.clear();
+            }
+            if(active.empty())
+                break;
+            ++nrounds;
+
+            //all the picked edges are in the forest (cut property with a strict order), an edge picked by
+            //both of its components is merged once: only that connect returns true
+            parallel::for_chunks(n, this->nthreads, [&](uint64_t lo, uint64_t hi, uint64_t t){
+                for(auto v=lo; v<hi; ++v){
+                    auto i = best[v].load(std::memory_order_relaxed);
+                    if(i == edge_weighted_graph_t::infinity) continue;
+                    best[v].store(edge_weighted_graph_t::infinity, std::memory_order_relaxed);
+                    if(uf.connect(g.edge(i).v, g.edge(i).w))
+                        local[t].push_back(i);
+                }
+            });
+            for(auto& l : local){
+                es.insert(es.end(), l.begin(), l.end());
+                l.clear();
+            }
+        }
+        finish();
+    }
+
+    //number of rounds
+    uint64_t rounds()const{return nrounds;}
+
+private:
+    //best = the lighter of best and i
+    void lightest(std::atomic<uint64_t>& best, uint64_t i){
+        auto cur = best.load(std::memory_order_relaxed);
+        while(cur == edge_weighted_graph_t::infinity || g.lighter(i, cur))
+            if(best.compare_exchange_weak(cur, i, std::memory_order_relaxed))
+                return;
+    }
+
+    uint64_t nthreads;
+    uint64_t nrounds{0};
+};
+
+#endif//__MSF_H__
@@ -0,0 +1,139 @@
+// to compile (e.g.): g++ -std=c++14 msf_client.cpp -O3 -pthread
+// to run (e.g.): ./a.out algo [threads] < datasets/tinyEWG.txt
+//      where algo: kruskal | filter_kruskal | boruvka
+//   or: ./a.out check [threads] < datasets/tinyEWG.txt
+//      all the algorithms on the input and on random graphs with many equal weights,
+//      the edge sets and the total weights must be the same
+//   or: ./a.out bench V E [threads] [seed]
+//      all the algorithms on a random graph with V vertices and E edges (uniform weights in [0, 1))
+
+#include "edge_weighted_graph.h"
+#include "msf.h"
+
+#include <chrono>
+#include <iomanip>
+#include <memory>
+#include <random>
+#include <string>
+
+#include <cstdlib>
+
+std::string default_algo = "kruskal";
+
+std::unique_ptr<msf_t> build_algorithm(edge_weighted_graph_t const& graph, std::string const& algo, uint64_t nthreads){
+    if(algo == "filter_kruskal")
+        return std::make_unique<filter_kruskal_msf_t>(graph, nthreads);
+    if(algo == "boruvka")
+        return std::make_unique<boruvka_msf_t>(graph, nthreads);
+    if(algo != default_algo)
+        std::cerr << "Invalid algo, use default algo" << std::endl;
+    return std::make_unique<kruskal_msf_t>(graph, nthreads);
+}
+
+//V vertices, E edges with random ends, weights in [0, 1) or (integer_weights) in {1, ..., 5}
+edge_weighted_graph_t random_graph(uint64_t V, uint64_t E, uint64_t seed, bool integer_weights = false){
+    std::mt19937_64 gen{seed};
+    std::uniform_int_distribution<uint64_t> vertex{0, V-1};
+    std::uniform_real_distribution<double> weight{0, 1};
+    std::uniform_int_distribution<int> small{1, 5};
+    std::vector<weighted_edge_t> es(E);
+    for(auto& e : es){
+        e.v = vertex(gen);
+        e.w = vertex(gen);
+        e.weight = integer_weights ? small(gen) : weight(gen);
+    }
+    return edge_weighted_graph_t{V, std::move(es)};
+}
+
+//every algorithm (with 1 and nthreads threads) must give the same forest
+bool same_forests(edge_weighted_graph_t const& graph, uint64_t nthreads, bool verbose){
+    kruskal_msf_t reference{graph, 1};
+    bool ok{true};
+    for(auto algo : {"kruskal", "filter_kruskal", "boruvka"}){
+        for(uint64_t t : {uint64_t(1), nthreads}){
+            auto msf = build_algorithm(graph, algo, t);
+            bool same = msf->edges() == reference.edges() && msf->weight() == reference.weight();
+            if(verbose || !same)
+                std::cout << algo << ", " << t << " thread(s) vs kruskal: " << (same ? "ok" : "different") << std::endl;
+            ok = ok && same;
+        }
+    }
+    return ok;
+}
+
+int main(int argc, char** argv){
+    if(argc < 2){
+        std::cerr << "Invalid number of arguments" << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::string algo = argv[1];
+
+    if(algo == "bench"){
+        if(argc < 4 || argc > 6){
+            std::cerr << "Invalid number of arguments" << std::endl;
+            return EXIT_FAILURE;
+        }
+        uint64_t V = std::stoull(argv[2]), E = std::stoull(argv[3]);
+        uint64_t nthreads = parallel::threads(argc > 4 ? std::stoull(argv[4]) : 0);
+        uint64_t seed = argc > 5 ? std::stoull(argv[5]) : 1;
+
+        auto start = std::chrono::steady_clock::now();
+        auto graph = random_graph(V, E, seed);
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "Vertices: " << V << ", edges: " << E << ", threads: " << nthreads
+                  << ", generation: " << elapsed << "s" << std::endl;
+
+        std::unique_ptr<msf_t> reference;
+        bool ok{true};
+        for(auto name : {"kruskal", "filter_kruskal", "boruvka"}){
+            start = std::chrono::steady_clock::now();
+            auto msf = build_algorithm(graph, name, nthreads);
+            elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            std::cout << std::left << std::setw(16) << name << elapsed << "s, weight: " << std::setprecision(12)
+                      << msf->weight() << std::setprecision(6) << ", trees: " << msf->trees() << std::endl;
+            if(!reference) reference = std::move(msf);
+            else ok = ok && msf->edges() == reference->edges() && msf->weight() == reference->weight();
+        }
+        std::cout << (ok ? "same forests" : "DIFFERENT FORESTS") << std::endl;
+        return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    if(argc > 3){
+        std::cerr << "Invalid number of arguments" << std::endl;
+        return EXIT_FAILURE;
+    }
+    uint64_t nthreads = argc == 3 ? std::stoull(argv[2]) : 0;
+
+    edge_weighted_graph_t graph;
+    std::cin >> graph;
+
+    if(algo == "check"){
+        nthreads = std::max<uint64_t>(4, parallel::threads(nthreads));
+        bool ok = same_forests(graph, nthreads, true);
+        uint64_t failures{0};
+        for(uint64_t seed=0; seed<200; ++seed){
+            auto V = 1 + seed % 50, E = seed * 7 % 300;
+            if(!same_forests(random_graph(V, E, seed, true), nthreads, false)) ++failures;
+        }
+        //something big enough for filter-Kruskal to split and for the parallel sort to use every thread
+        if(!same_forests(random_graph(5000, 200000, 7, true), nthreads, false)) ++failures;
+        std::cout << "random graphs: " << (failures ? "different" : "ok") << std::endl;
+        return ok && !failures ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    auto msf = build_algorithm(graph, algo, nthreads);
+
+    std::cout << std::fixed << std::setprecision(5);
+    for(auto i : msf->edges()){
+        auto& e = graph.edge(i);
+        std::cout << e.v << "-" << e.w << " " << e.weight << '\n';
+    }
+    std::cout << msf->weight() << std::endl;
+
+    return EXIT_SUCCESS;
+}
+
+/*
+results:
+tinyEWG     ->  1.81000 (7 edges)
+*/
@@ -0,0 +1,198 @@
+// to compile (e.g.): g++ -std=c++14 basic_biconnected_comps_client.cpp -O3 -pthread
+// to run (e.g.): ./a.out algo < datasets/tinyG.txt
+//      where algo: tarjan | tarjan_vishkin | check
+//   or: ./a.out check 300
+//      the same check on 300 random graphs of up to 30 vertices (nothing read from stdin)
+
+// check: runs both algorithms and compares them with a brute force version
+// (remove each edge/vertex and look at the connectivity of what is left), small graphs only
+
+#include "graph.h"
+#include "biconnected_comps.h"
+#include "writer.h"
+
+#include <memory>
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+
+#include <cstdlib>
+
+std::string default_algo = "tarjan";
+
+std::unique_ptr<biconnected_comps_t> build_algorithm(graph_t const& graph, std::string const& algo){
+    if(algo == "tarjan_vishkin")
+        return std::make_unique<tarjan_vishkin_biconnected_comps_t>(graph);
+    if(algo != default_algo)
+        std::cerr << "Invalid algo, use default algo" << std::endl;
+    return std::make_unique<tarjan_biconnected_comps_t>(graph);
+}
+
+namespace brute_force{
+    //marks the vertices reachable from s without using the vertex x or the edge e
+    std::vector<bool> reach(graph_t const& g, uint64_t s, uint64_t x, edge_t e){
+        std::vector<bool> marked(g.vertices(), false);
+        std::vector<uint64_t> stack{s};
+        marked[s] = true;
+        while(!stack.empty()){
+            auto v = stack.back(); stack.pop_back();
+            for(auto w : g.adj(v)){
+                if(marked[w] || w == x || make_edge(v, w) == e) continue;
+                marked[w] = true;
+                stack.push_back(w);
+            }
+        }
+        return marked;
+    }
+
+    //an edge is a bridge if its ends are not connected without it
+    std::vector<edge_t> bridges(graph_t const& g){
+        std::vector<edge_t> result;
+        for(uint64_t v=0; v<g.vertices(); ++v)
+            for(auto w : g.adj(v))
+                if(v < w && !reach(g, v, infinity, edge_t{v, w})[w])
+                    result.push_back(edge_t{v, w});
+        return result;
+    }
+
+    //a vertex is an articulation point if its neighbours are not connected without it
+    std::vector<uint64_t> articulation_points(graph_t const& g){
+        std::vector<uint64_t> result;
+        for(uint64_t v=0; v<g.vertices(); ++v){
+            auto& adj = g.adj(v);
+            if(adj.empty()) continue;
+            auto marked = reach(g, *adj.begin(), v, edge_t{infinity, infinity});
+            for(auto w : adj)
+                if(!marked[w]){result.push_back(v); break;}
+        }
+        return result;
+    }
+
+    //two edges v-a and v-b are in the same component iff a and b are connected without v
+    std::vector<std::vector<edge_t>> components(graph_t const& g){
+        std::vector<edge_t> edges;
+        for(uint64_t v=0; v<g.vertices(); ++v)
+            for(auto w : g.adj(v))
+                if(v < w) edges.push_back(edge_t{v, w});
+        auto index = [&](uint64_t v, uint64_t w){
+            return std::lower_bound(edges.begin(), edges.end(), make_edge(v, w)) - edges.begin();
+        };
+
+        union_find_weighted_quick_union_path_compression uf{edges.size()};
+        for(uint64_t v=0; v<g.vertices(); ++v){
+            for(auto a : g.adj(v)){
+                auto marked = reach(g, a, v, edge_t{infinity, infinity});
+                for(auto b : g.adj(v))
+                    if(a < b && marked[b])
+                        uf.connect(index(v, a), index(v, b));
+            }
+        }
+
+        std::vector<std::vector<edge_t>> result(edges.size());
+        for(uint64_t i=0; i<edges.size(); ++i)
+            result[uf.find(i)].push_back(edges[i]);
+        result.erase(std::remove_if(result.begin(), result.end(), [](std::vector<edge_t> const& c){return c.empty();}), result.end());
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+}
+
+bool same(biconnected_comps_t const& bc, std::vector<std::vector<edge_t>> const& comps,
+          std::vector<edge_t> const& bridges, std::vector<uint64_t> const& aps){
+    if(bc.count() != comps.size()) return false;
+    for(uint64_t i=0; i<comps.size(); ++i)
+        if(bc.component(i) != comps[i]) return false;
+    return bc.bridges() == bridges && bc.articulation_points() == aps;
+}
+
+//both algorithms against the brute force version
+bool check(graph_t const& graph, bool verbose){
+    auto comps = brute_force::components(graph);
+    auto bridges = brute_force::bridges(graph);
+    auto aps = brute_force::articulation_points(graph);
+
+    bool ok{true};
+    for(auto name : {"tarjan", "tarjan_vishkin"}){
+        auto bc = build_algorithm(graph, name);
+        bool s = same(*bc, comps, bridges, aps);
+        if(verbose || !s)
+            std::cout << name << " vs brute force: " << (s ? "ok" : "different") << std::endl;
+        ok = ok && s;
+    }
+    return ok;
+}
+
+//a random graph (in the format of the datasets) with 1..30 vertices, from trees with a few extra edges
+//(many bridges and articulation points) to dense graphs
+std::string random_dataset(std::mt19937_64& gen){
+    std::uniform_int_distribution<uint64_t> size{1, 30};
+    uint64_t n = size(gen);
+    std::uniform_int_distribution<uint64_t> vertex{0, n-1};
+    std::uniform_int_distribution<uint64_t> extra{0, n * (n-1) / 4};
+    std::set<std::pair<uint64_t, uint64_t>> edges;
+    auto add = [&edges](uint64_t v, uint64_t w){if(v != w) edges.insert(std::make_pair(std::min(v, w), std::max(v, w)));};
+    //a random forest: every vertex hangs from an earlier one (or starts a new tree)
+    for(uint64_t v=1; v<n; ++v)
+        if(gen() % 8) add(v, std::uniform_int_distribution<uint64_t>{0, v-1}(gen));
+    for(uint64_t e = extra(gen) >> (gen() % 4); e>0; --e)
+        add(vertex(gen), vertex(gen));
+
+    std::ostringstream os;
+    os << n << '\n' << edges.size() << '\n';
+    for(auto& e : edges)
+        os << e.first << ' ' << e.second << '\n';
+    return os.str();
+}
+
+int main(int argc, char** argv){
+    if(argc > 3 || (argc == 3 && std::string(argv[1]) != "check")){
+        std::cerr << "Invalid number of arguments" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    auto algo = default_algo;
+    if(argc >= 2) algo = argv[1];
+
+    if(algo == "check" && argc == 3){
+        uint64_t n = std::stoull(argv[2]), failures{0};
+        std::mt19937_64 gen{2024};
+        for(uint64_t i=0; i<n; ++i){
+            graph_t graph;
+            std::istringstream is{random_dataset(gen)};
+            is >> graph;
+            failures += !check(graph, false);
+        }
+        std::cout << n << " random graphs, " << failures << " different" << std::endl;
+        return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+    }
+
+    graph_t graph;
+    std::cin >> graph;
+
+    if(algo == "check")
+        return check(graph, true) ? EXIT_SUCCESS : EXIT_FAILURE;
+
+    auto bc = build_algorithm(graph, algo);
+
+    writer_t out{std::cout};
+    out << "Number of biconnected components: " << bc->count() << '\n';
+    for(uint64_t c = 0; c<bc->count(); ++c){
+        out << "Component " << c << ": ";
+        for(auto& e : bc->component(c))
+            out << e.first << "-" << e.second << " ";
+        out << '\n';
+    }
+
+    out << "Bridges: ";
+    for(auto& e : bc->bridges())
+        out << e.first << "-" << e.second << " ";
+    out << '\n';
+
+    out << "Articulation points: ";
+    for(auto v : bc->articulation_points())
+        out << v << " ";
+    out << '\n';
+
+    return EXIT_SUCCESS;
+}
@@ -3,6 +3,8 @@
 
 #include "graph.h"
 #include "bipartite_detector.h"
+#include "traversal_stats.h"
+#include "writer.h"
 
 #include <cstdlib>
 
@@ -12,27 +14,40 @@ int main(int argc, char** argv){
         return EXIT_FAILURE;
     }
 
+    //compile with -DSTATS to get the traversal stats (json, on stderr)
+    traversal_stats_t stats;
+
     graph_t graph;
-    std::cin >> graph;
+    {
+        auto timer = stats.phase("load");
+        std::cin >> graph;
+    }
 
     bipartite_detector_t detector{graph};
+    stats += detector.stats();
+    writer_t out{std::cout};
     if(detector.positive()){
         auto& labels = detector.get_labels();
 
-        std::cout << "Partition A: ";
-        for(auto v=0; v<graph.vertices(); ++v)
+        out << "Partition A: ";
+        for(uint64_t v=0; v<graph.vertices(); ++v)
             if(labels[v] == label_t::neg)
-                std::cout << v << " ";
-        std::cout << std::endl;
+                out << v << " ";
+        out << '\n';
 
-        std::cout << "Partition B: ";
-        for(auto v=0; v<graph.vertices(); ++v)
+        out << "Partition B: ";
+        for(uint64_t v=0; v<graph.vertices(); ++v)
             if(labels[v] == label_t::pos)
-                std::cout << v << " ";
-        std::cout << std::endl;
+                out << v << " ";
+        out << '\n';
     }else{
-        std::cout << "Not bipartite" << std::endl;
+        out << "Not bipartite" << '\n';
     }
+    out.flush();
+
+#ifdef STATS
+    std::cerr << stats << std::endl;
+#endif
 
     return EXIT_SUCCESS;
 }
@@ -3,6 +3,8 @@
 
 #include "graph.h"
 #include "connected_comps.h"
+#include "traversal_stats.h"
+#include "writer.h"
 
 #include <cstdlib>
 
@@ -12,12 +14,20 @@ int main(int argc, char** argv){
         return EXIT_FAILURE;
     }
 
+    //compile with -DSTATS to get the traversal stats (json, on stderr)
+    traversal_stats_t stats;
+
     graph_t graph;
-    std::cin >> graph;
+    {
+        auto timer = stats.phase("load");
+        std::cin >> graph;
+    }
 
     connected_comps_t cc{graph};
+    stats += cc.stats();
 
-    std::cout << "Number of connected components: " << cc.count() << std::endl;
+    writer_t out{std::cout};
+    out << "Number of connected components: " << cc.count() << '\n';
 
     std::vector<std::vector<uint64_t>> components{cc.count()};
     for(uint64_t v = 0; v<graph.vertices(); ++v){
@@ -25,11 +35,16 @@ int main(int argc, char** argv){
     }
 
     for(uint64_t c = 0; c<components.size(); ++c){
-        std::cout << "Component " << c << ": ";
+        out << "Component " << c << ": ";
         for(uint64_t v = 0; v<components[c].size(); ++v)
-            std::cout << components[c][v] << " ";
-        std::cout << std::endl;
+            out << components[c][v] << " ";
+        out << '\n';
     }
+    out.flush();
+
+#ifdef STATS
+    std::cerr << stats << std::endl;
+#endif
 
     return EXIT_SUCCESS;
 }
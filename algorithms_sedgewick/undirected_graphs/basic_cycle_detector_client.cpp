@@ -3,6 +3,8 @@
 
 #include "graph.h"
 #include "cycle_detector.h"
+#include "traversal_stats.h"
+#include "writer.h"
 
 #include <cstdlib>
 
@@ -12,18 +14,31 @@ int main(int argc, char** argv){
         return EXIT_FAILURE;
     }
 
+    //compile with -DSTATS to get the traversal stats (json, on stderr)
+    traversal_stats_t stats;
+
     graph_t graph;
-    std::cin >> graph;
+    {
+        auto timer = stats.phase("load");
+        std::cin >> graph;
+    }
 
     cycle_detector_t detector{graph};
+    stats += detector.stats();
+    writer_t out{std::cout};
     if(detector.positive()){
-        std::cout << "First detected cycle: ";
+        out << "First detected cycle: ";
         for(auto e : detector.get_cycle())
-            std::cout << e << " ";
-        std::cout << std::endl;
+            out << e << " ";
+        out << '\n';
     }else{
-        std::cout << "No cycle detected" << std::endl;
+        out << "No cycle detected" << '\n';
     }
+    out.flush();
+
+#ifdef STATS
+    std::cerr << stats << std::endl;
+#endif
 
     return EXIT_SUCCESS;
 }
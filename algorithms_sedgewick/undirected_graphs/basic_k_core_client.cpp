@@ -0,0 +1,90 @@
+// to compile (e.g.): g++ -std=c++14 basic_k_core_client.cpp -O3 -pthread
+// to run (e.g.): ./a.out algo [threads] < datasets/mediumG.txt
+//      where algo: bz | peeling | check | bench
+
+// check: compares the parallel peeling (1 and 4 threads) with Batagelj-Zaversnik
+// bench: timings of both, e.g. on a generated power-law graph:
+//      ./power_law_graph 200000 16 2.1 > powerlaw.txt && ./a.out bench < powerlaw.txt
+
+#include "graph.h"
+#include "k_core.h"
+#include "writer.h"
+
+#include <chrono>
+#include <memory>
+#include <string>
+
+#include <cstdlib>
+
+std::string default_algo = "bz";
+
+std::unique_ptr<k_core_t> build_algorithm(graph_t const& graph, std::string const& algo, uint64_t nthreads){
+    if(algo == "peeling")
+        return std::make_unique<peeling_k_core_t>(graph, nthreads);
+    if(algo != default_algo)
+        std::cerr << "Invalid algo, use default algo" << std::endl;
+    return std::make_unique<bz_k_core_t>(graph);
+}
+
+int main(int argc, char** argv){
+    if(argc > 3){
+        std::cerr << "Invalid number of arguments" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    auto algo = default_algo;
+    if(argc > 1) algo = argv[1];
+    uint64_t nthreads = argc > 2 ? std::stoull(argv[2]) : 0;
+
+    graph_t graph;
+    std::cin >> graph;
+
+    if(algo == "check"){
+        bz_k_core_t expected{graph};
+        bool ok{true};
+        for(uint64_t t : {1, 4}){
+            peeling_k_core_t kc{graph, t};
+            bool same = kc.degeneracy() == expected.degeneracy();
+            for(uint64_t v=0; same && v<graph.vertices(); ++v)
+                same = kc.core(v) == expected.core(v);
+            std::cout << "peeling, " << t << " thread(s) vs bz: " << (same ? "ok" : "different") << std::endl;
+            ok = ok && same;
+        }
+        return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    if(algo == "bench"){
+        auto time_it = [](auto&& build){
+            auto start = std::chrono::steady_clock::now();
+            build();
+            return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        };
+        uint64_t degeneracy{0};
+        double t = time_it([&]{degeneracy = bz_k_core_t{graph}.degeneracy();});
+        std::cout << "bz: degeneracy " << degeneracy << ", " << t << "s" << std::endl;
+        std::vector<uint64_t> threads{1};
+        if(parallel::threads(nthreads) > 1) threads.push_back(parallel::threads(nthreads));
+        for(auto n : threads){
+            uint64_t rounds{0};
+            t = time_it([&]{
+                peeling_k_core_t kc{graph, n};
+                degeneracy = kc.degeneracy();
+                rounds = kc.rounds();
+            });
+            std::cout << "peeling, " << n << " thread(s): degeneracy " << degeneracy << ", "
+                      << rounds << " rounds, " << t << "s" << std::endl;
+        }
+        return EXIT_SUCCESS;
+    }
+
+    auto kc = build_algorithm(graph, algo, nthreads);
+
+    writer_t out{std::cout};
+    out << "Degeneracy: " << kc->degeneracy() << '\n';
+    for(uint64_t k=1; k<=kc->degeneracy(); ++k)
+        out << k << "-core: " << kc->size(k) << " vertices" << '\n';
+    for(uint64_t v=0; v<graph.vertices(); ++v)
+        out << "Vertex " << v << ": " << kc->core(v) << '\n';
+
+    return EXIT_SUCCESS;
+}
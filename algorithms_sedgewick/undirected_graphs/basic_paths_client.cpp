@@ -7,11 +7,21 @@
 // run: ./a.out dfs_eq_rec < datasets/tinyG.txt > dfs_eq_rec.txt
 // the following command should return 0 : sdiff -s dfs_rec.txt dfs_eq_rec.txt | wc -l
 
+// the three ways of getting a path (path_to(w), path_to(w, buffer), reverse_path_to(w)) must agree,
+// and the output through writer_t (default and tiny buffers) must be the same as through std::ostream
+// run: ./a.out check < datasets/mediumG.txt
+
 #include "graph.h"
 #include "paths.h"
+#include "traversal_stats.h"
+#include "writer.h"
 
+#include <algorithm>
 #include <map>
 #include <string>
+#include <memory>
+#include <functional>
+#include <sstream>
 
 #include <cstdlib>
 
@@ -34,38 +44,107 @@ std::unique_ptr<paths_t> build_algorithm(graph_t const& graph, uint64_t source,
     return (str_to_algo[default_algo])(graph,source);
 }
 
-int main(int argc, char** argv){
-    if (argc != 1 && argc != 2){
-        std::cerr << "Invalid number of arguments" << std::endl;
-        return EXIT_FAILURE;
-    }
-
-    auto algo = default_algo;
-    if (argc == 2) algo = argv[1];
-
-    graph_t graph;
-    std::cin >> graph;
+//the paths from every vertex (std::ostream or writer_t)
+template<typename Out>
+void print(graph_t const& graph, std::string const& algo, Out& out, traversal_stats_t& stats){
+    //one buffer for all the paths
+    std::vector<uint64_t> path;
 
     for(uint64_t v = 0; v < graph.vertices(); ++v){
         auto paths = build_algorithm(graph, v, algo);
 
-        std::cout << "From " << v << " to" <<std::endl;
+        out << "From " << v << " to" << '\n';
         for(uint64_t w = 0; w < graph.vertices(); ++w){
             if (v == w) continue;
 
-            std::cout << "\t" << w;
+            out << "\t" << w;
             if(paths->connected_to(w)){
-                std::cout << " (dist: " << paths->distance_to(w) << ") -> ";
-                auto path = paths->path_to(w);
+                out << " (dist: " << paths->distance_to(w) << ") -> ";
+                paths->path_to(w, path);
                 for (auto vw : path)
-                    std::cout << vw << " ";
+                    out << vw << " ";
             } else {
-                std::cout << " -> no path";
+                out << " -> no path";
             }
-            std::cout << std::endl;
+            out << '\n';
+        }
+        out << '\n';
+        stats += paths->stats();
+    }
+}
+
+//every algo, every pair of vertices: the deque, the buffer and the reversed lazy view are the same path
+bool check(graph_t const& graph){
+    std::vector<uint64_t> path, reversed;
+    uint64_t paths{0}, errors{0};
+    for(auto algo : {"dfs_rec", "dfs_eq_rec", "dfs", "bfs"}){
+        for(uint64_t v = 0; v < graph.vertices(); ++v){
+            auto p = build_algorithm(graph, v, algo);
+            for(uint64_t w = 0; w < graph.vertices(); ++w){
+                if(!p->connected_to(w)) continue;
+                auto expected = p->path_to(w);
+                p->path_to(w, path);
+                auto rp = p->reverse_path_to(w);
+                reversed.assign(rp.begin(), rp.end());
+                std::reverse(reversed.begin(), reversed.end());
+                bool same = std::equal(expected.begin(), expected.end(), path.begin(), path.end())
+                         && std::equal(expected.begin(), expected.end(), reversed.begin(), reversed.end())
+                         && rp.size() == expected.size();
+                errors += !same;
+                ++paths;
+            }
+        }
+    }
+    std::cout << "paths compared: " << paths << ", different: " << errors << std::endl;
+
+    //the buffer is smaller than a line (or than a number) with the tiny capacities
+    traversal_stats_t stats;
+    std::ostringstream expected;
+    print(graph, "bfs", expected, stats);
+    expected << uint64_t(-1) << ' ' << std::numeric_limits<int64_t>::min() << ' ' << -1 << '\n';
+    bool same{true};
+    for(uint64_t capacity : {0, 1, 20, 64, 1 << 16}){
+        std::ostringstream os;
+        {
+            writer_t out{os, capacity};
+            print(graph, "bfs", out, stats);
+            out << uint64_t(-1) << ' ' << std::numeric_limits<int64_t>::min() << ' ' << -1 << '\n';
         }
-        std::cout << std::endl;
+        same = same && os.str() == expected.str();
+    }
+    std::cout << "writer_t output: " << (same ? "same" : "DIFFERENT") << std::endl;
+    return errors == 0 && same;
+}
+
+int main(int argc, char** argv){
+    if (argc != 1 && argc != 2){
+        std::cerr << "Invalid number of arguments" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    auto algo = default_algo;
+    if (argc == 2) algo = argv[1];
+
+    //compile with -DSTATS to get the traversal stats (json, on stderr), summed over all the sources
+    traversal_stats_t stats;
+
+    graph_t graph;
+    {
+        auto timer = stats.phase("load");
+        std::cin >> graph;
     }
 
+    if(algo == "check")
+        return check(graph) ? EXIT_SUCCESS : EXIT_FAILURE;
+
+    //one buffered output (no flush per line)
+    writer_t out{std::cout};
+    print(graph, algo, out, stats);
+    out.flush();
+
+#ifdef STATS
+    std::cerr << stats << std::endl;
+#endif
+
     return EXIT_SUCCESS;
 }
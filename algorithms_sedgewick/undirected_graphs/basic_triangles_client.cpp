@@ -0,0 +1,108 @@
+// to compile (e.g.): g++ -std=c++14 basic_triangles_client.cpp -O3 -pthread
+// to run (e.g.): ./a.out algo [threads] < datasets/mediumG.txt
+//      where algo: merge | gallop | simd | check | bench
+
+// check: runs every intersection kind (1 and 4 threads) against a brute force count (small graphs only)
+// bench: timings of every intersection kind, e.g. on a generated power-law graph:
+//      ./power_law_graph 200000 16 2.1 > powerlaw.txt && ./a.out bench < powerlaw.txt
+
+#include "graph.h"
+#include "triangles.h"
+#include "writer.h"
+
+#include <chrono>
+#include <numeric>
+#include <string>
+
+#include <cstdlib>
+
+std::string default_algo = "simd";
+
+intersection_t kind_of(std::string const& algo){
+    if(algo == "merge") return intersection_t::merge;
+    if(algo == "gallop") return intersection_t::gallop;
+    if(algo != default_algo)
+        std::cerr << "Invalid algo, use default algo" << std::endl;
+    return intersection_t::simd;
+}
+
+namespace brute_force{
+    //every triangle is found from its smallest vertex
+    std::vector<uint64_t> triangles(graph_t const& g){
+        std::vector<uint64_t> per_v(g.vertices(), 0);
+        for(uint64_t u=0; u<g.vertices(); ++u)
+            for(auto v : g.adj(u))
+                for(auto w : g.adj(u))
+                    if(u < v && v < w && g.adj(v).count(w)){
+                        ++per_v[u]; ++per_v[v]; ++per_v[w];
+                    }
+        return per_v;
+    }
+}
+
+int main(int argc, char** argv){
+    if(argc > 3){
+        std::cerr << "Invalid number of arguments" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    auto algo = default_algo;
+    if(argc > 1) algo = argv[1];
+    uint64_t nthreads = argc > 2 ? std::stoull(argv[2]) : 0;
+
+    graph_t graph;
+    std::cin >> graph;
+
+    if(algo == "check"){
+        auto expected = brute_force::triangles(graph);
+        bool ok{true};
+        for(auto kind : {intersection_t::merge, intersection_t::gallop, intersection_t::simd}){
+            for(uint64_t t : {1, 4}){
+                triangles_t tc{graph, kind, true, t};
+                bool same = tc.count() * 3 == std::accumulate(expected.begin(), expected.end(), uint64_t{0});
+                for(uint64_t v=0; same && v<graph.vertices(); ++v)
+                    same = tc.count(v) == expected[v];
+                std::cout << tc.name() << ", " << t << " thread(s) vs brute force: " << (same ? "ok" : "different") << std::endl;
+                ok = ok && same;
+            }
+        }
+        return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    if(algo == "bench"){
+        uint64_t edges{0}, maxdeg{0};
+        for(uint64_t v=0; v<graph.vertices(); ++v){
+            edges += graph.adj(v).size();
+            maxdeg = std::max<uint64_t>(maxdeg, graph.adj(v).size());
+        }
+        std::cout << "Vertices: " << graph.vertices() << ", edges: " << edges / 2 << ", max degree: " << maxdeg << std::endl;
+
+        //the orientation (part of every run below) on its own
+        auto start = std::chrono::steady_clock::now();
+        auto dag = csr_graph_t::degree_oriented(graph);
+        double oriented = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "Degree orientation: " << oriented << "s, max out degree: " << dag.max_degree() << std::endl;
+
+        std::vector<uint64_t> threads{1};
+        if(parallel::threads(nthreads) > 1) threads.push_back(parallel::threads(nthreads));
+        for(auto kind : {intersection_t::merge, intersection_t::gallop, intersection_t::simd}){
+            for(auto t : threads){
+                start = std::chrono::steady_clock::now();
+                triangles_t tc{graph, kind, false, t};
+                double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                std::cout << tc.name() << ", " << t << " thread(s): " << tc.count() << " triangles, "
+                          << elapsed << "s (" << elapsed - oriented << "s counting)" << std::endl;
+            }
+        }
+        return EXIT_SUCCESS;
+    }
+
+    triangles_t tc{graph, kind_of(algo), true, nthreads};
+
+    writer_t out{std::cout};
+    out << "Number of triangles: " << tc.count() << '\n';
+    for(uint64_t v=0; v<graph.vertices(); ++v)
+        out << "Vertex " << v << ": " << tc.count(v) << '\n';
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,305 @@
+#ifndef __BICONNECTED_COMPS_H__
+#define __BICONNECTED_COMPS_H__
+
+#include "graph.h"
+#include "parallel.h"
+#include "../union_find/uf_impl.h"
+
+#include <algorithm>
+#include <stack>
+#include <utility>
+
+//Single points of failure in an undirected graph...
+
+/*
+
+biconnected component   maximal set of edges such that any two of them lie on a common simple cycle
+                        (every edge belongs to exactly one of them)
+bridge                  an edge whose removal disconnects the graph = a biconnected component with a single edge
+articulation point      a vertex whose removal disconnects the graph = a vertex in more than one component
+
+Both algorithms take time proportional to E+V:
+    Tarjan              one dfs, low[v] = smallest preorder reachable from the subtree of v with one back edge
+    Tarjan-Vishkin      any spanning tree + preorder numbers, the components are the connected components
+                        of an auxiliary graph over the tree edges (the per vertex work runs in parallel)
+
+*/
+
+//an undirected edge, always stored as (min, max)
+using edge_t = std::pair<uint64_t, uint64_t>;
+edge_t make_edge(uint64_t v, uint64_t w){return v < w ? edge_t{v, w} : edge_t{w, v};}
+
+struct biconnected_comps_t{
+    biconnected_comps_t(graph_t const& g) : g{g}{assert(g.is_valid());}
+
+    //just to force this type to be only base class
+    virtual ~biconnected_comps_t() = 0;
+
+    //returns the total number of biconnected components
+    uint64_t count()const{return comps.size();}
+
+    //the edges of the i-th component (sorted, components are sorted by their first edge)
+    std::vector<edge_t> const& component(uint64_t i)const{
+        assert(i < comps.size());
+        return comps[i];
+    }
+
+    //the bridges (sorted)
+    std::vector<edge_t> const& bridges()const{return brs;}
+
+    //the articulation points (sorted)
+    std::vector<uint64_t> const& articulation_points()const{return aps;}
+
+protected:
+    //computes the bridges and the articulation points from the components
+    //and puts everything in a canonical order (so that the algorithms can be compared)
+    void finish(){
+        for(auto& c : comps)
+            std::sort(c.begin(), c.end());
+        std::sort(comps.begin(), comps.end());
+
+        std::vector<uint64_t> seen_in(g.vertices(), infinity);
+        std::vector<uint64_t> ncomps(g.vertices(), 0);
+        for(uint64_t i=0; i<comps.size(); ++i){
+            if(comps[i].size() == 1)
+                brs.push_back(comps[i][0]);
+            for(auto& e : comps[i]){
+                for(auto x : {e.first, e.second}){
+                    if(seen_in[x] != i){
+                        seen_in[x] = i;
+                        ++ncomps[x];
+                    }
+                }
+            }
+        }
+        std::sort(brs.begin(), brs.end());
+        for(uint64_t v=0; v<g.vertices(); ++v)
+            if(ncomps[v] > 1)
+                aps.push_back(v);
+    }
+
+    graph_t const& g;
+
+    std::vector<std::vector<edge_t>> comps;
+    std::vector<edge_t> brs;
+    std::vector<uint64_t> aps;
+};
+
+biconnected_comps_t::~biconnected_comps_t(){};
+
+//Tarjan's low-link dfs, iterative (an explicit stack of frames) so it cannot overflow the call stack
+struct tarjan_biconnected_comps_t : public biconnected_comps_t{
+    tarjan_biconnected_comps_t(graph_t const& g) : biconnected_comps_t(g){
+        pre.resize(g.vertices(), infinity);
+        low.resize(g.vertices(), infinity);
+        for(uint64_t v=0; v<g.vertices(); ++v)
+            if(pre[v] == infinity) dfs(v);
+        finish();
+    }
+
+private:
+    struct frame_t{
+        uint64_t v;
+        uint64_t parent;
+        std::set<uint64_t>::const_iterator it;
+    };
+
+    void dfs(uint64_t root){
+        std::stack<frame_t> frames;
+        visit(frames, root, infinity);
+
+        while(!frames.empty()){
+            auto& f = frames.top();
+            auto v = f.v;
+            if(f.it != g.adj(v).end()){
+                auto w = *f.it++;
+                if(pre[w] == infinity){
+                    edges.push(edge_t{v, w});
+                    visit(frames, w, v);
+                }else if(w != f.parent && pre[w] < pre[v]){
+                    //back edge
+                    edges.push(edge_t{v, w});
+                    low[v] = std::min(low[v], pre[w]);
+                }
+            }else{
+                auto u = f.parent;
+                frames.pop();
+                if(u == infinity)
+                    continue;
+                low[u] = std::min(low[u], low[v]);
+                //nothing below v can reach above u => the edges pushed since u-v form a component
+                if(low[v] >= pre[u]){
+                    comps.emplace_back();
+                    edge_t e;
+                    do{
+                        e = edges.top(); edges.pop();
+                        comps.back().push_back(make_edge(e.first, e.second));
+                    }while(e != edge_t{u, v});
+                }
+            }
+        }
+    }
+
+    void visit(std::stack<frame_t>& frames, uint64_t v, uint64_t parent){
+        pre[v] = low[v] = time++;
+        frames.push(frame_t{v, parent, g.adj(v).begin()});
+    }
+
+    std::vector<uint64_t> pre;
+    std::vector<uint64_t> low;
+    std::stack<edge_t> edges;
+    uint64_t time{0};
+};
+
+//Tarjan-Vishkin: spanning tree + preorder, then the components are found as the connected
+//components (union-find) of an auxiliary graph whose vertices are the tree edges
+struct tarjan_vishkin_biconnected_comps_t : public biconnected_comps_t{
+    tarjan_vishkin_biconnected_comps_t(graph_t const& g, uint64_t nthreads = 0)
+        : biconnected_comps_t(g), nthreads{parallel::threads(nthreads)}
+    {
+        spanning_forest();
+        low_high();
+        components();
+        finish();
+    }
+
+private:
+    //bfs forest, then preorder numbers (pre) and subtree sizes (nd) on that forest
+    void spanning_forest(){
+        uint64_t n{g.vertices()};
+        parent.assign(n, infinity);
+        std::vector<bool> marked(n, false);
+
+        //children of every vertex, bfs order (CSR)
+        std::vector<uint64_t> order;
+        std::vector<uint64_t> roots;
+        for(uint64_t r=0; r<n; ++r){
+            if(marked[r]) continue;
+            roots.push_back(r);
+            marked[r] = true;
+            order.push_back(r);
+            for(uint64_t i=order.size()-1; i<order.size(); ++i){
+                auto v = order[i];
+                for(auto w : g.adj(v)){
+                    if(!marked[w]){
+                        marked[w] = true;
+                        parent[w] = v;
+                        order.push_back(w);
+                    }
+                }
+            }
+        }
+        std::vector<uint64_t> first(n+1, 0);
+        for(uint64_t v=0; v<n; ++v)
+            if(parent[v] != infinity) ++first[parent[v]+1];
+        for(uint64_t v=0; v<n; ++v)
+            first[v+1] += first[v];
+        std::vector<uint64_t> children(first[n]);
+        auto next = first;
+        for(auto v : order)
+            if(parent[v] != infinity) children[next[parent[v]]++] = v;
+
+        //iterative preorder
+        pre.assign(n, 0);
+        by_pre.clear();
+        std::stack<uint64_t> stack;
+        for(auto r : roots){
+            stack.push(r);
+            while(!stack.empty()){
+                auto v = stack.top(); stack.pop();
+                pre[v] = by_pre.size();
+                by_pre.push_back(v);
+                for(auto i = first[v+1]; i > first[v]; --i)
+                    stack.push(children[i-1]);
+            }
+        }
+
+        nd.assign(n, 1);
+        for(auto i = n; i > 0; --i){
+            auto v = by_pre[i-1];
+            if(parent[v] != infinity) nd[parent[v]] += nd[v];
+        }
+    }
+
+    bool tree_edge(uint64_t v, uint64_t w)const{return parent[v] == w || parent[w] == v;}
+    //is a an ancestor of b (or b itself)?
+    bool ancestor(uint64_t a, uint64_t b)const{return pre[a] <= pre[b] && pre[b] < pre[a] + nd[a];}
+
+    //low/high: smallest/largest preorder number reachable from the subtree of v with one non tree edge
+    void low_high(){
+        uint64_t n{g.vertices()};
+        low.resize(n);
+        high.resize(n);
+        parallel::for_chunks(n, nthreads, [this](uint64_t lo, uint64_t hi, uint64_t){
+            for(uint64_t v=lo; v<hi; ++v){
+                low[v] = high[v] = pre[v];
+                for(auto w : g.adj(v)){
+                    if(tree_edge(v, w)) continue;
+                    low[v] = std::min(low[v], pre[w]);
+                    high[v] = std::max(high[v], pre[w]);
+                }
+            }
+        });
+        //children before parents
+        for(auto i = n; i > 0; --i){
+            auto v = by_pre[i-1];
+            auto u = parent[v];
+            if(u == infinity) continue;
+            low[u] = std::min(low[u], low[v]);
+            high[u] = std::max(high[u], high[v]);
+        }
+    }
+
+    //the tree edge (parent[v], v) is represented by v
+    void components(){
+        uint64_t n{g.vertices()};
+
+        //the edges of the auxiliary graph, found in parallel
+        std::vector<std::vector<edge_t>> links(nthreads);
+        parallel::for_chunks(n, nthreads, [this, &links](uint64_t lo, uint64_t hi, uint64_t t){
+            for(uint64_t v=lo; v<hi; ++v){
+                //a non tree edge between two unrelated vertices links their tree edges
+                for(auto w : g.adj(v))
+                    if(pre[v] < pre[w] && !tree_edge(v, w) && !ancestor(v, w))
+                        links[t].push_back(edge_t{v, w});
+
+                //the tree edge u-v is linked to the one above u if the subtree of v escapes the subtree of u
+                auto u = parent[v];
+                if(u != infinity && parent[u] != infinity)
+                    if(low[v] < pre[u] || high[v] >= pre[u] + nd[u])
+                        links[t].push_back(edge_t{u, v});
+            }
+        });
+
+        union_find_weighted_quick_union_path_compression uf{n};
+        for(auto& l : links)
+            for(auto& e : l)
+                uf.connect(e.first, e.second);
+
+        //every edge goes to the component of the tree edge of its deeper (larger preorder) end
+        std::vector<uint64_t> comp_of(n, infinity);
+        for(uint64_t v=0; v<n; ++v){
+            for(auto w : g.adj(v)){
+                if(v > w) continue;
+                auto x = pre[v] > pre[w] ? v : w;
+                auto r = uf.find(x);
+                if(comp_of[r] == infinity){
+                    comp_of[r] = comps.size();
+                    comps.emplace_back();
+                }
+                comps[comp_of[r]].push_back(edge_t{v, w});
+            }
+        }
+    }
+
+    uint64_t nthreads;
+
+    std::vector<uint64_t> parent;
+    std::vector<uint64_t> pre;
+    std::vector<uint64_t> by_pre;
+    std::vector<uint64_t> nd;
+    std::vector<uint64_t> low;
+    std::vector<uint64_t> high;
+};
+
+#endif//__BICONNECTED_COMPS_H__
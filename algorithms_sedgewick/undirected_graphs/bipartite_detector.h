@@ -2,6 +2,7 @@
 #define __BIPARTITE_DETECTOR_H__
 
 #include "graph.h"
+#include "traversal_stats.h"
 
 //Bipartite is a graph whose vertices can be divided
 //into two disjunct sets (POS and NEG) such that every
@@ -11,6 +12,7 @@ struct bipartite_detector_t{
     //finds if an undirected graph is bipartite or not
     bipartite_detector_t(graph_t const& g) : g{g}{
         assert(g.is_valid());
+        auto timer = st.phase("traversal");
         neg_or_pos.resize(g.vertices(), label_t::unknown);
         for(uint64_t v=0; v<g.vertices(); ++v){
             if(neg_or_pos[v] == label_t::unknown){
@@ -27,12 +29,17 @@ struct bipartite_detector_t{
         assert(bipartite == label_t::pos);
         return neg_or_pos;
     }
+
+    //what the traversal did (empty unless compiled with -DSTATS)
+    traversal_stats_t const& stats()const{return st;}
 private:
     void dfs(uint64_t u, uint64_t v){
         neg_or_pos[v] = inv(neg_or_pos[u]);
+        auto frame = st.enter();
         for(auto w : g.adj(v)){
             if(bipartite == label_t::neg)
                 return;
+            st.scan();
             if(neg_or_pos[w]==label_t::unknown){
                 dfs(v, w);
             }else if(neg_or_pos[w] == neg_or_pos[v]){
@@ -45,6 +52,8 @@ private:
 
     std::vector<label_t> neg_or_pos;
     label_t bipartite{label_t::unknown};
+
+    traversal_stats_t st;
 };
 
 #endif//__BIPARTITE_DETECTOR_H__
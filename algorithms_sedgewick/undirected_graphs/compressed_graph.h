@@ -0,0 +1,174 @@
+#ifndef __COMPRESSED_GRAPH_H__
+#define __COMPRESSED_GRAPH_H__
+
+#include "graph.h"
+
+#include <iterator>
+
+//Compressed read-only represenation for static graphs...
+
+/*
+
+Every adjacency set is already sorted, so instead of the neighbours we store the gaps between them:
+
+    adj(v) = w0 < w1 < ... < wk     ->      zigzag(w0 - v), w1 - w0 - 1, ..., wk - wk-1 - 1
+
+and every number is written as a byte aligned varint (7 bits of payload per byte, the high bit
+says "more bytes follow"). Small gaps (the common case for graphs with any kind of locality)
+take a single byte instead of the 8 bytes of a plain uint64_t.
+
+The lists are concatenated in one byte array and offsets[v] gives the begining of adj(v),
+so random access to a vertex is still O(1); the neighbours are decoded on the fly while iterating.
+
+representation          space (bytes per edge, both directions stored)
+adjacency set           2 * ~48 (one rb-tree node per neighbour)
+flat adjacency array    2 * 8
+compressed              2 * (1..10), typically close to 2 * 1-2
+
+*/
+
+namespace varint{
+    //appends x to out, returns the number of bytes written
+    uint64_t encode(uint64_t x, std::vector<uint8_t>& out){
+        uint64_t n{1};
+        while(x >= 0x80){
+            out.push_back(uint8_t(x | 0x80));
+            x >>= 7;
+            ++n;
+        }
+        out.push_back(uint8_t(x));
+        return n;
+    }
+
+    //decodes one number starting at p, p is moved after it
+    inline uint64_t decode(uint8_t const*& p){
+        uint64_t x{*p & 0x7fu};
+        for(uint64_t shift{7}; *p++ & 0x80; shift += 7)
+            x |= uint64_t(*p & 0x7fu) << shift;
+        return x;
+    }
+
+    inline uint64_t zigzag(int64_t x){return (uint64_t(x) << 1) ^ uint64_t(x >> 63);}
+    inline int64_t unzigzag(uint64_t x){return int64_t(x >> 1) ^ -int64_t(x & 1);}
+}
+
+struct compressed_graph_t{
+    //decodes the neighbours of a vertex one at a time
+    struct adj_iterator{
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = uint64_t;
+        using difference_type = std::ptrdiff_t;
+        using pointer = uint64_t const*;
+        using reference = uint64_t const&;
+
+        adj_iterator() = default;
+        adj_iterator(uint8_t const* at, uint8_t const* end, uint64_t v) : at{at}, next{at}, end{end}{
+            if(at != end)
+                w = v + varint::unzigzag(varint::decode(next));
+        }
+
+        uint64_t const& operator*()const{return w;}
+
+        adj_iterator& operator++(){
+            at = next;
+            if(at != end)
+                w += varint::decode(next) + 1;
+            return *this;
+        }
+        adj_iterator operator++(int){auto it = *this; ++*this; return it;}
+
+        bool operator==(adj_iterator const& o)const{return at == o.at;}
+        bool operator!=(adj_iterator const& o)const{return at != o.at;}
+
+    private:
+        uint8_t const* at{nullptr};     //begining of the current neighbour
+        uint8_t const* next{nullptr};   //begining of the next one
+        uint8_t const* end{nullptr};
+        uint64_t w{0};                  //the current (decoded) neighbour
+    };
+
+    //the neighbours of a vertex (a light view, it can be kept by value)
+    struct adj_range{
+        adj_iterator begin()const{return adj_iterator{first, last, v};}
+        adj_iterator end()const{return adj_iterator{last, last, v};}
+        bool empty()const{return first == last;}
+
+        uint8_t const* first;
+        uint8_t const* last;
+        uint64_t v;
+    };
+
+    compressed_graph_t() = default;
+
+    //compress an already loaded graph
+    explicit compressed_graph_t(graph_t const& g){
+        assert(g.is_valid());
+
+        offsets.reserve(g.vertices()+1);
+        for(uint64_t v=0; v < g.vertices(); ++v){
+            offsets.push_back(data.size());
+
+            uint64_t prev{v};
+            bool first{true};
+            for(auto w : g.adj(v)){
+                varint::encode(first ? varint::zigzag(int64_t(w - v)) : w - prev - 1, data);
+                prev = w;
+                first = false;
+                ++nedges;
+            }
+        }
+        offsets.push_back(data.size());
+        data.shrink_to_fit();
+
+        nedges /= 2;
+        valid = true;
+    }
+
+    bool is_valid() const {return valid;}
+
+    //number or vertices
+    uint64_t vertices()const{
+        assert(valid);
+        return offsets.size()-1;
+    }
+
+    //number of (undirected) edges
+    uint64_t edges()const{
+        assert(valid);
+        return nedges;
+    }
+
+    //vertices adjancent to v, decoded while iterating
+    adj_range adj(uint64_t v)const{
+        assert(valid);
+        assert(v < vertices());
+        return adj_range{data.data() + offsets[v], data.data() + offsets[v+1], v};
+    }
+
+    //memory used by the representation (the offsets included)
+    uint64_t bytes()const{return data.size() + offsets.size() * sizeof(uint64_t);}
+
+private:
+    bool valid{false};
+    uint64_t nedges{0};
+
+    //adj(v) is encoded in data[offsets[v], offsets[v+1])
+    std::vector<uint64_t> offsets;
+    std::vector<uint8_t> data;
+};
+
+//display the graph (same format as graph_t)
+std::ostream& operator<<(std::ostream& os, compressed_graph_t const& g){
+    assert(g.is_valid());
+
+    os  << "Number of vertices: " << g.vertices() << std::endl;
+    for(uint64_t v=0; v < g.vertices(); ++v){
+        os << v << ": ";
+        for(auto w : g.adj(v))
+            os << w << " ";
+        os << std::endl;
+    }
+    return os;
+}
+
+#endif//__COMPRESSED_GRAPH_H__
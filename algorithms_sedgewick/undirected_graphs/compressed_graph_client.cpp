@@ -0,0 +1,94 @@
+// to compile (e.g.): g++ -std=c++14 compressed_graph_client.cpp -O3
+// to run (e.g.): ./a.out [sources] < datasets/mediumG.txt
+//      where sources: number of bfs sources used to time the traversals (default 100)
+
+// compares the compressed represenation against graph_t:
+//  - memory (bytes per edge)
+//  - traversal time (bfs from a few sources + connected components) on both
+//  - the results (distances, components) must be identical
+
+#include "graph.h"
+#include "compressed_graph.h"
+#include "paths.h"
+#include "connected_comps.h"
+
+#include <chrono>
+#include <iomanip>
+#include <string>
+
+#include <cstdlib>
+
+template<typename F>
+double time_it(F&& f){
+    auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+//runs bfs from each source and connected components, returns a checksum of the results
+template<typename G>
+uint64_t traverse(G const& g, std::vector<uint64_t> const& sources){
+    uint64_t checksum{0};
+    for(auto s : sources){
+        basic_bfs_paths_t<G> paths{g, s};
+        for(uint64_t w = 0; w < g.vertices(); ++w)
+            if(paths.connected_to(w))
+                checksum = checksum * 31 + paths.distance_to(w);
+    }
+    basic_connected_comps_t<G> cc{g};
+    for(uint64_t v = 0; v < g.vertices(); ++v)
+        checksum = checksum * 31 + cc.id(v);
+    return checksum;
+}
+
+int main(int argc, char** argv){
+    if(argc != 1 && argc != 2){
+        std::cerr << "Invalid number of arguments" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    uint64_t nsources = 100;
+    if(argc == 2) nsources = std::stoull(argv[1]);
+
+    graph_t graph;
+    std::cin >> graph;
+
+    compressed_graph_t cgraph{graph};
+
+    uint64_t V{cgraph.vertices()}, E{cgraph.edges()};
+    std::cout << "Number of vertices: " << V << std::endl;
+    std::cout << "Number of edges: " << E << std::endl;
+
+    //the rb-tree node of a std::set<uint64_t> is 40 bytes, 48 after malloc rounding
+    double set_bytes = 2.0 * E * 48 + V * sizeof(std::set<uint64_t>);
+    double flat_bytes = 2.0 * E * sizeof(uint64_t) + (V+1) * sizeof(uint64_t);
+    double compressed_bytes = cgraph.bytes();
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Bytes per edge (adjacency set, approx): " << set_bytes / std::max<uint64_t>(E, 1) << std::endl;
+    std::cout << "Bytes per edge (flat u64 array):        " << flat_bytes / std::max<uint64_t>(E, 1) << std::endl;
+    std::cout << "Bytes per edge (compressed):            " << compressed_bytes / std::max<uint64_t>(E, 1) << std::endl;
+
+    std::vector<uint64_t> sources;
+    nsources = std::min(nsources, V);
+    for(uint64_t i = 0; i < nsources; ++i)
+        sources.push_back(i * V / nsources);
+
+    uint64_t sum_set{0}, sum_compressed{0};
+    double t_set = time_it([&]{sum_set = traverse(graph, sources);});
+    double t_compressed = time_it([&]{sum_compressed = traverse(cgraph, sources);});
+
+    std::cout << std::setprecision(4);
+    std::cout << "Traversal time (adjacency set): " << t_set << "s" << std::endl;
+    std::cout << "Traversal time (compressed):    " << t_compressed << "s" << std::endl;
+    std::cout << std::setprecision(2);
+    std::cout << "Slowdown: " << t_compressed / t_set << "x" << std::endl;
+
+    if(sum_set != sum_compressed){
+        std::cerr << "Results differ between the two representations" << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << "Results: identical" << std::endl;
+
+    return EXIT_SUCCESS;
+}
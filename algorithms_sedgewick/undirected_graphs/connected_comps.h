@@ -2,11 +2,15 @@
 #define __CONNECTED_COMPS_H__
 
 #include "graph.h"
+#include "traversal_stats.h"
 
-struct connected_comps_t{
+//written against the graph interface (is_valid, vertices, adj), see paths.h
+template<typename G>
+struct basic_connected_comps_t{
     //finds the list of connected components
-    connected_comps_t(graph_t const& g) : g{g}{
+    basic_connected_comps_t(G const& g) : g{g}{
         assert(g.is_valid());
+        auto timer = st.phase("traversal");
         cc.resize(g.vertices(), infinity);
         for(uint64_t v=0; v<g.vertices(); ++v)
             if(cc[v] == infinity){ dfs(v); ncc++; }
@@ -29,17 +33,27 @@ struct connected_comps_t{
     //returns the total number of connected components
     uint64_t count()const{return ncc;}
 
+    //what the traversal did (empty unless compiled with -DSTATS)
+    traversal_stats_t const& stats()const{return st;}
+
 private:
     void dfs(uint64_t v){
         cc[v] = ncc;
-        for(auto w : g.adj(v))
+        auto frame = st.enter();
+        for(auto w : g.adj(v)){
+            st.scan();
             if(cc[w] == infinity) dfs(w);
+        }
     }
 
-    graph_t const& g;
+    G const& g;
 
     std::vector<uint64_t> cc;
     uint64_t ncc{0};
+
+    traversal_stats_t st;
 };
 
+using connected_comps_t = basic_connected_comps_t<graph_t>;
+
 #endif//__CONNECTED_COMPS_H__
@@ -0,0 +1,111 @@
+#ifndef __CSR_GRAPH_H__
+#define __CSR_GRAPH_H__
+
+#include "graph.h"
+
+#include <algorithm>
+
+//Flat read-only represenation for static graphs (compressed sparse rows)...
+
+/*
+
+All the adjacency lists are concatenated in one array of 32 bit vertex ids, offsets[v] gives the
+begining of adj(v). Every list stays sorted (it is copied from the std::set of graph_t), so two lists
+can be intersected with a merge, without any pointer chasing.
+
+symmetric           every edge v-w is stored twice (w in adj(v) and v in adj(w))
+degree oriented     every edge is stored once, from the end with the smaller (degree, id) to the other one:
+                    the result is acyclic and no vertex keeps more than sqrt(2E) neighbours, even the hubs
+                    of a power-law graph (used to count triangles, each one is seen exactly once)
+
+*/
+
+struct csr_graph_t{
+    //the neighbours of a vertex (a light view, it can be kept by value)
+    struct adj_range{
+        uint32_t const* begin()const{return first;}
+        uint32_t const* end()const{return last;}
+        uint64_t size()const{return uint64_t(last - first);}
+        bool empty()const{return first == last;}
+
+        uint32_t const* first;
+        uint32_t const* last;
+    };
+
+    csr_graph_t() = default;
+
+    //every edge in both directions
+    explicit csr_graph_t(graph_t const& g){
+        build(g, [](uint64_t, uint64_t){return true;});
+    }
+
+    //every edge once, oriented from the smaller (degree, id) to the larger one
+    static csr_graph_t degree_oriented(graph_t const& g){
+        csr_graph_t r;
+        r.build(g, [&g](uint64_t v, uint64_t w){
+            auto dv = g.adj(v).size(), dw = g.adj(w).size();
+            return dv < dw || (dv == dw && v < w);
+        });
+        return r;
+    }
+
+    bool is_valid() const {return valid;}
+
+    //number or vertices
+    uint64_t vertices()const{
+        assert(valid);
+        return offsets.size()-1;
+    }
+
+    //number of stored (directed) edges
+    uint64_t arcs()const{
+        assert(valid);
+        return targets.size();
+    }
+
+    uint64_t degree(uint64_t v)const{
+        assert(valid);
+        assert(v < vertices());
+        return offsets[v+1] - offsets[v];
+    }
+
+    uint64_t max_degree()const{return maxdeg;}
+
+    //vertices adjancent to v (sorted)
+    adj_range adj(uint64_t v)const{
+        assert(valid);
+        assert(v < vertices());
+        return adj_range{targets.data() + offsets[v], targets.data() + offsets[v+1]};
+    }
+
+    //memory used by the representation (the offsets included)
+    uint64_t bytes()const{return targets.size() * sizeof(uint32_t) + offsets.size() * sizeof(uint64_t);}
+
+private:
+    template<typename Keep>
+    void build(graph_t const& g, Keep&& keep){
+        assert(g.is_valid());
+        assert(g.vertices() <= std::numeric_limits<uint32_t>::max());
+
+        offsets.reserve(g.vertices()+1);
+        for(uint64_t v=0; v < g.vertices(); ++v){
+            offsets.push_back(targets.size());
+            for(auto w : g.adj(v))
+                if(keep(v, w))
+                    targets.push_back(uint32_t(w));
+            maxdeg = std::max<uint64_t>(maxdeg, targets.size() - offsets.back());
+        }
+        offsets.push_back(targets.size());
+        targets.shrink_to_fit();
+        valid = true;
+    }
+
+    bool valid{false};
+    uint64_t maxdeg{0};
+
+    //adj(v) is targets[offsets[v], offsets[v+1])
+    std::vector<uint64_t> offsets;
+    std::vector<uint32_t> targets;
+};
+
+#endif//__CSR_GRAPH_H__
@@ -2,6 +2,7 @@
 #define __CYCLE_DETECTOR_H__
 
 #include "graph.h"
+#include "traversal_stats.h"
 
 #include <deque>
 
@@ -9,6 +10,7 @@ struct cycle_detector_t{
     //finds cycles in an undirected graph
     cycle_detector_t(graph_t const& g) : g{g}{
         assert(g.is_valid());
+        auto timer = st.phase("traversal");
         marked.resize(g.vertices(), false);
         edge_to.resize(g.vertices(), infinity);
         for(uint64_t v=0; v<g.vertices(); ++v)
@@ -20,17 +22,23 @@ struct cycle_detector_t{
         assert(cycle.size());
         return cycle;
     }
+
+    //what the traversal did (empty unless compiled with -DSTATS)
+    traversal_stats_t const& stats()const{return st;}
 private:
     void dfs(uint64_t u, uint64_t v){
         marked[v] = true;
+        auto frame = st.enter();
         for(auto w : g.adj(v)){
             if(cycle.size())
                 return;
 
+            st.scan();
             if(!marked[w]){
                 edge_to[w] = v;
                 dfs(v, w);
             }else if(w!=u){
+                auto timer = st.phase("path_reconstruction");
                 build_path(v,w);
             }
         }
@@ -51,6 +59,8 @@ private:
     std::vector<bool> marked;
     std::vector<uint64_t> edge_to;
     std::deque<uint64_t> cycle;
+
+    traversal_stats_t st;
 };
 
 #endif//__CYCLE_DETECTOR_H__
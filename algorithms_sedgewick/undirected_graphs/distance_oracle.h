@@ -0,0 +1,265 @@
+#ifndef __DISTANCE_ORACLE_H__
+#define __DISTANCE_ORACLE_H__
+
+#include "graph.h"
+#include "parallel.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <iostream>
+#include <string>
+
+//Approximate distances from a few landmarks...
+
+/*
+
+An exact distance_to is a whole bfs from the source (E+V). Instead, k landmarks are picked once,
+the bfs distances from each of them to every vertex are stored, and for any u, v (triangle inequality):
+
+    max_i |d(l_i, u) - d(l_i, v)|   <=   d(u, v)   <=   min_i d(l_i, u) + d(l_i, v)
+
+both bounds in O(k). When u and v are on opposite sides of a landmark the upper bound is exact,
+which is why landmarks with a central position (high degree) or spread out (farthest point) work well.
+
+landmark selection
+    degree          the k vertices with the highest degree, the k bfs run in parallel
+    farthest        the first one is the vertex with the highest degree, every next one is the vertex of
+                    its component farthest from all the previous ones (in a power-law graph the hub is in the
+                    giant component); each bfs needs the previous ones, they run one at a time
+
+index               V * k distances of 16 bits, stored per vertex (a query reads 2 rows of k values)
+                    0xffff = unreachable from that landmark (if only one of u, v is reachable from a
+                    landmark they are in different components and the distance is infinity)
+                    0xfffe = reachable but at least that far (saturated): such a landmark gives no upper
+                    bound, only a lower one against a vertex at an exact distance
+exact fallback      a bfs from u that stops at v, at depth upper - 1 (the upper bound is already a path)
+                    or right away when lower == upper
+serialization       binary: magic, version, V, k, the landmarks, the distances (native endianness)
+
+*/
+
+enum class landmarks_t {degree, farthest};
+
+template<typename G>
+struct basic_distance_oracle_t{
+    static constexpr uint16_t unreachable = 0xffff;
+    //the distance is >= far (it does not fit in the index)
+    static constexpr uint16_t far = 0xfffe;
+
+    struct bounds_t{
+        uint64_t lower;
+        uint64_t upper;
+    };
+
+    //builds the index: k landmarks, one bfs from each of them
+    basic_distance_oracle_t(G const& g, uint64_t k, landmarks_t strategy = landmarks_t::degree, uint64_t nthreads = 0)
+        : g{g}, n{g.vertices()}
+    {
+        assert(g.is_valid());
+        k = std::min(k, n);
+        nthreads = parallel::threads(nthreads);
+
+        //(the interface only has adj(v), counting the neighbours of a hub is not free)
+        std::vector<uint64_t> degree(n);
+        for(uint64_t v=0; v<n; ++v)
+            degree[v] = std::distance(g.adj(v).begin(), g.adj(v).end());
+
+        //one column per landmark while building, transposed at the end
+        std::vector<std::vector<uint16_t>> columns(k);
+        if(strategy == landmarks_t::degree){
+            std::vector<uint64_t> by_degree(n);
+            for(uint64_t v=0; v<n; ++v) by_degree[v] = v;
+            std::partial_sort(by_degree.begin(), by_degree.begin() + k, by_degree.end(), [&degree](uint64_t a, uint64_t b){
+                return degree[a] > degree[b] || (degree[a] == degree[b] && a < b);
+            });
+            landmarks.assign(by_degree.begin(), by_degree.begin() + k);
+
+            std::vector<std::vector<uint64_t>> queues(nthreads);
+            parallel::for_dynamic(k, nthreads, 1, [&](uint64_t lo, uint64_t hi, uint64_t t){
+                for(auto i=lo; i<hi; ++i)
+                    bfs(landmarks[i], columns[i], queues[t]);
+            });
+        }else{
+            std::vector<uint64_t> queue;
+            //distance from the closest landmark so far
+            std::vector<uint16_t> closest(n, unreachable);
+            uint64_t next{0};
+            for(uint64_t v=1; v<n; ++v)
+                if(degree[v] > degree[next]) next = v;
+            for(uint64_t i=0; i<k; ++i){
+                landmarks.push_back(next);
+                bfs(next, columns[i], queue);
+                uint64_t farthest{next};
+                for(uint64_t v=0; v<n; ++v){
+                    closest[v] = std::min(closest[v], columns[i][v]);
+                    //(the landmarks are at 0, they are never picked again)
+                    if(closest[v] != unreachable && closest[v] > closest[farthest]) farthest = v;
+                }
+                //the component is smaller than k
+                if(farthest == next) break;
+                next = farthest;
+            }
+            columns.resize(landmarks.size());
+            k = landmarks.size();
+        }
+
+        dist.resize(n * k);
+        parallel::for_chunks(n, nthreads, [&](uint64_t lo, uint64_t hi, uint64_t){
+            for(auto v=lo; v<hi; ++v)
+                for(uint64_t i=0; i<k; ++i)
+                    dist[v * k + i] = columns[i][v];
+        });
+    }
+
+    //reads an index written by save (g must be the graph it was built on)
+    basic_distance_oracle_t(G const& g, std::istream& is) : g{g}, n{g.vertices()}{
+        char m[sizeof(magic)];
+        uint64_t version{0}, vertices{0}, k{0};
+        is.read(m, sizeof(m));
+        read(is, version);
+        read(is, vertices);
+        read(is, k);
+        if(!is || std::memcmp(m, magic, sizeof(m)) != 0 || version != 1)
+            throw std::runtime_error("Not a distance oracle index");
+        if(vertices != n)
+            throw std::runtime_error("The index was built on another graph");
+        //the landmarks are distinct vertices
+        if(k > n)
+            throw std::runtime_error("Invalid number of landmarks in the index");
+        landmarks.resize(k);
+        is.read(reinterpret_cast<char*>(landmarks.data()), std::streamsize(k * sizeof(uint64_t)));
+        if(!is)
+            throw std::runtime_error("Truncated distance oracle index");
+        for(auto l : landmarks)
+            if(l >= n)
+                throw std::runtime_error("Invalid landmark in the index");
+
+        //in blocks, so that a truncated file fails before the whole index is allocated
+        const uint64_t block = uint64_t(1) << 20;
+        for(uint64_t done=0; done < n * k; done += block){
+            auto m = std::min(block, n * k - done);
+            dist.resize(done + m);
+            is.read(reinterpret_cast<char*>(dist.data() + done), std::streamsize(m * sizeof(uint16_t)));
+            if(!is)
+                throw std::runtime_error("Truncated distance oracle index");
+        }
+        for(uint64_t i=0; i<k; ++i)
+            if(dist[landmarks[i] * k + i] != 0)
+                throw std::runtime_error("Invalid distances in the index");
+    }
+
+    void save(std::ostream& os)const{
+        uint64_t version{1}, k{landmarks.size()};
+        os.write(magic, sizeof(magic));
+        write(os, version);
+        write(os, n);
+        write(os, k);
+        os.write(reinterpret_cast<char const*>(landmarks.data()), std::streamsize(k * sizeof(uint64_t)));
+        os.write(reinterpret_cast<char const*>(dist.data()), std::streamsize(dist.size() * sizeof(uint16_t)));
+    }
+
+    //lower <= d(u, v) <= upper, (infinity, infinity) if they are not connected,
+    //upper is infinity when no landmark reaches both
+    bounds_t bounds(uint64_t u, uint64_t v)const{
+        assert(u < n && v < n);
+        if(u == v) return bounds_t{0, 0};
+        uint64_t k{landmarks.size()};
+        auto du = dist.data() + u * k, dv = dist.data() + v * k;
+        uint64_t lower{0}, upper{infinity};
+        for(uint64_t i=0; i<k; ++i){
+            if(du[i] == unreachable && dv[i] == unreachable) continue;
+            if(du[i] == unreachable || dv[i] == unreachable) return bounds_t{infinity, infinity};
+            uint64_t a{du[i]}, b{dv[i]};
+            //d(l, x) >= far: only a lower bound, and only against an exact distance
+            if(a == far || b == far){
+                if(a != b) lower = std::max<uint64_t>(lower, far - std::min(a, b));
+                continue;
+            }
+            lower = std::max(lower, a > b ? a - b : b - a);
+            upper = std::min(upper, a + b);
+        }
+        return bounds_t{lower, upper};
+    }
+
+    uint64_t upper_bound(uint64_t u, uint64_t v)const{return bounds(u, v).upper;}
+    uint64_t lower_bound(uint64_t u, uint64_t v)const{return bounds(u, v).lower;}
+
+    //exact distance (infinity if not connected): a bfs bounded by the landmark bounds
+    //(not thread safe: it reuses the scratch buffers of the oracle)
+    uint64_t distance(uint64_t u, uint64_t v)const{
+        auto b = bounds(u, v);
+        if(b.lower == b.upper) return b.upper;
+        if(seen.size() != n) seen.assign(n, 0);
+        //after a wrap around every vertex would look seen
+        if(++stamp == 0){
+            seen.assign(n, 0);
+            stamp = 1;
+        }
+        frontier.clear();
+        frontier.push_back(u);
+        seen[u] = stamp;
+        //levels 1..upper-1, reaching upper means the upper bound was right
+        for(uint64_t depth=1; depth<b.upper && !frontier.empty(); ++depth){
+            next.clear();
+            for(auto x : frontier){
+                for(auto w : g.adj(x)){
+                    if(seen[w] == stamp) continue;
+                    if(w == v) return depth;
+                    seen[w] = stamp;
+                    next.push_back(w);
+                }
+            }
+            std::swap(frontier, next);
+        }
+        return b.upper;
+    }
+
+    std::vector<uint64_t> const& landmark_vertices()const{return landmarks;}
+
+    //memory used by the index
+    uint64_t bytes()const{return dist.size() * sizeof(uint16_t) + landmarks.size() * sizeof(uint64_t);}
+
+private:
+    static constexpr char magic[8] = {'L', 'M', 'K', 'O', 'R', 'C', 'L', 'E'};
+
+    template<typename T> static void read(std::istream& is, T& x){is.read(reinterpret_cast<char*>(&x), sizeof(x));}
+    template<typename T> static void write(std::ostream& os, T const& x){os.write(reinterpret_cast<char const*>(&x), sizeof(x));}
+
+    //distances from s to every vertex (saturated at far)
+    void bfs(uint64_t s, std::vector<uint16_t>& d, std::vector<uint64_t>& queue)const{
+        d.assign(n, unreachable);
+        queue.clear();
+        queue.push_back(s);
+        d[s] = 0;
+        for(uint64_t i=0; i<queue.size(); ++i){
+            auto x = queue[i];
+            auto dw = uint16_t(std::min<uint64_t>(d[x] + 1, far));
+            for(auto w : g.adj(x)){
+                if(d[w] != unreachable) continue;
+                d[w] = dw;
+                queue.push_back(w);
+            }
+        }
+    }
+
+    G const& g;
+    uint64_t n;
+    std::vector<uint64_t> landmarks;
+    //dist[v * k + i] = d(landmarks[i], v)
+    std::vector<uint16_t> dist;
+
+    //scratch for the exact fallback
+    mutable std::vector<uint32_t> seen;
+    mutable uint32_t stamp{0};
+    mutable std::vector<uint64_t> frontier, next;
+};
+
+template<typename G> constexpr char basic_distance_oracle_t<G>::magic[8];
+template<typename G> constexpr uint16_t basic_distance_oracle_t<G>::unreachable;
+template<typename G> constexpr uint16_t basic_distance_oracle_t<G>::far;
+
+//on the default representation
+using distance_oracle_t = basic_distance_oracle_t<graph_t>;
+
+#endif//__DISTANCE_ORACLE_H__
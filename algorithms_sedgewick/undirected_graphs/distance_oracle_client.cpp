@@ -0,0 +1,121 @@
+// to compile (e.g.): g++ -std=c++14 distance_oracle_client.cpp -O3 -pthread
+// to run (e.g.): ./a.out 16 degree [sources] [threads] < datasets/mediumG.txt
+//      where 16: number of landmarks, degree | farthest: how they are picked,
+//      sources: number of random sources the oracle is compared on (default 20)
+
+// reports the build time, the size of the index, the query latency (bounds and exact fallback)
+// and the error of the bounds against bfs_paths_t (every vertex reachable from every source);
+// the index is also written to memory and read back, the answers must not change
+
+#include "graph.h"
+#include "paths.h"
+#include "distance_oracle.h"
+
+#include <chrono>
+#include <random>
+#include <sstream>
+#include <string>
+
+#include <cstdlib>
+
+template<typename F>
+double time_it(F&& f){
+    auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv){
+    if(argc < 2 || argc > 5){
+        std::cerr << "Invalid number of arguments" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    uint64_t k = std::stoull(argv[1]);
+    auto strategy = argc > 2 && std::string(argv[2]) == "farthest" ? landmarks_t::farthest : landmarks_t::degree;
+    uint64_t nsources = argc > 3 ? std::stoull(argv[3]) : 20;
+    uint64_t nthreads = argc > 4 ? std::stoull(argv[4]) : 0;
+
+    graph_t graph;
+    std::cin >> graph;
+    if(graph.vertices() == 0)
+        return EXIT_SUCCESS;
+
+    std::unique_ptr<distance_oracle_t> oracle;
+    double t_build = time_it([&]{oracle = std::make_unique<distance_oracle_t>(graph, k, strategy, nthreads);});
+    std::cout << "Landmarks: " << oracle->landmark_vertices().size()
+              << (strategy == landmarks_t::degree ? " (degree)" : " (farthest)") << std::endl
+              << "Build time: " << t_build << "s" << std::endl
+              << "Index size: " << oracle->bytes() << " bytes ("
+              << double(oracle->bytes()) / graph.vertices() << " per vertex)" << std::endl;
+
+    //serialization round trip
+    std::stringstream buffer;
+    oracle->save(buffer);
+    distance_oracle_t loaded{graph, buffer};
+
+    std::mt19937_64 gen{7};
+    std::uniform_int_distribution<uint64_t> pick{0, graph.vertices() - 1};
+
+    uint64_t pairs{0}, finite_upper{0}, exact_upper{0}, tight{0}, violations{0}, fallback_errors{0}, roundtrip_errors{0};
+    double rel_upper{0}, rel_lower{0}, t_bfs{0}, t_bounds{0}, t_fallback{0};
+    uint64_t fallback_queries{0};
+    std::vector<uint64_t> targets;
+    for(uint64_t s=0; s<nsources; ++s){
+        auto u = pick(gen);
+        std::unique_ptr<bfs_paths_t> bfs;
+        t_bfs += time_it([&]{bfs = std::make_unique<bfs_paths_t>(graph, u);});
+
+        targets.clear();
+        for(uint64_t v=0; v<graph.vertices(); ++v)
+            if(v != u && bfs->connected_to(v)) targets.push_back(v);
+
+        std::vector<distance_oracle_t::bounds_t> answers(targets.size());
+        t_bounds += time_it([&]{
+            for(uint64_t i=0; i<targets.size(); ++i)
+                answers[i] = oracle->bounds(u, targets[i]);
+        });
+
+        for(uint64_t i=0; i<targets.size(); ++i){
+            auto d = bfs->distance_to(targets[i]);
+            auto b = answers[i];
+            auto l = loaded.bounds(u, targets[i]);
+            roundtrip_errors += l.lower != b.lower || l.upper != b.upper;
+            violations += b.lower > d || b.upper < d;
+            exact_upper += b.upper == d;
+            tight += b.lower == b.upper;
+            if(b.upper != infinity){
+                rel_upper += double(b.upper - d) / d;
+                ++finite_upper;
+            }
+            rel_lower += double(d - std::min(b.lower, d)) / d;
+            ++pairs;
+        }
+
+        //the exact fallback on a few targets per source
+        for(uint64_t i=0; i<targets.size() && i<100; ++i){
+            auto v = targets[(i * 7919) % targets.size()];
+            uint64_t d{0};
+            t_fallback += time_it([&]{d = oracle->distance(u, v);});
+            fallback_errors += d != bfs->distance_to(v);
+            ++fallback_queries;
+        }
+    }
+
+    std::cout << "Pairs compared: " << pairs << " (from " << nsources << " sources)" << std::endl;
+    if(pairs){
+        std::cout << "Exact bfs_paths_t: " << t_bfs / nsources * 1e3 << "ms per source" << std::endl
+                  << "Bounds query: " << t_bounds / pairs * 1e9 << "ns" << std::endl
+                  << "Exact fallback query: " << (fallback_queries ? t_fallback / fallback_queries * 1e6 : 0) << "us" << std::endl
+                  << "Upper bound exact: " << 100.0 * exact_upper / pairs << "%" << std::endl
+                  << "Lower bound = upper bound: " << 100.0 * tight / pairs << "%" << std::endl
+                  << "Mean relative error (upper): " << (finite_upper ? rel_upper / finite_upper : 0)
+                  << " (" << finite_upper << " pairs with an upper bound)" << std::endl
+                  << "Mean relative error (lower): " << rel_lower / pairs << std::endl;
+    }
+    std::cout << "Bound violations: " << violations << std::endl
+              << "Fallback errors: " << fallback_errors << std::endl
+              << "Serialization errors: " << roundtrip_errors << std::endl;
+
+    return violations || fallback_errors || roundtrip_errors ? EXIT_FAILURE : EXIT_SUCCESS;
+}
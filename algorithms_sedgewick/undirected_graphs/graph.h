@@ -4,6 +4,9 @@
 #include <iostream>
 #include <vector>
 #include <set>
+#include <limits>
+#include <stdexcept>
+#include <cstdint>
 #include <cassert>
 
 //some useful conventions
@@ -40,6 +43,13 @@ struct graph_t{
         return adjs[v];
     }
 
+    //is there an edge between v and w? (looked up in the smaller of the two sets)
+    bool has_edge(uint64_t v, uint64_t w)const{
+        assert(valid);
+        assert(v < adjs.size() && w < adjs.size());
+        return adjs[v].size() <= adjs[w].size() ? adjs[v].count(w) != 0 : adjs[w].count(v) != 0;
+    }
+
 private:
     friend std::istream& operator>>(std::istream& is, graph_t& g);
 
@@ -81,18 +91,18 @@ std::istream& operator>>(std::istream& is, graph_t& g){
 
     uint64_t n{0};
     uint64_t e{0};
-    std::cin >> n;
-    std::cin >> e;
+    is >> n;
+    is >> e;
 
     g.set_size(n);
 
     uint64_t cnt_e{0};
-    if(!std::cin.eof()){
+    if(!is.eof()){
         while(true){
             uint64_t v,w;
             try{
-                std::cin >> v >> w;
-                if(std::cin.eof())
+                is >> v >> w;
+                if(is.eof())
                     break;
                 g.add_edge(v,w);
                 ++cnt_e;
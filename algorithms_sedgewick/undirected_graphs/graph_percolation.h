@@ -0,0 +1,159 @@
+#ifndef __GRAPH_PERCOLATION_H__
+#define __GRAPH_PERCOLATION_H__
+
+#include "graph.h"
+#include "csr_graph.h"
+#include "parallel.h"
+#include "../union_find/uf_impl.h"
+#include "../union_find/percolation.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+
+//Site and bond percolation on any graph...
+
+/*
+
+site        the vertices are opened one by one in a random order, an open vertex is connected to its
+            open neighbours
+bond        every vertex is there from the start, the edges are opened one by one in a random order
+
+Every sample is one Newman-Ziff sweep: everything is opened (V or E steps), merged incrementally in a
+weighted quick union with path compression, and the size of the largest component is recorded after
+every step (Q_n, n = number of open vertices / edges). The curve for any p is the binomial average of
+the mean Q_n (binomial_convolution in ../union_find/percolation.h), not one simulation per p.
+
+threshold   there is no "top" and "bottom" in a general graph, so the threshold of a sample is the step
+            where the largest component grows the most at once (the giant component appears), over the
+            number of steps; the estimate is the mean over the samples
+
+samples     spread over the threads, sample i is shuffled with the seeds (seed, i) whatever the number
+            of threads, the sums are integers: the result does not depend on the number of threads
+
+*/
+
+enum class percolation_t {site, bond};
+
+struct percolation_curve_t{
+    percolation_t kind;
+    uint64_t vertices;
+    uint64_t samples;
+    //largest[n]: mean size of the largest component after n steps, as a fraction of the vertices
+    std::vector<double> largest;
+    //mean and standard error of the per sample thresholds
+    double threshold;
+    double threshold_error;
+
+    //number of steps of a sweep (vertices or edges)
+    uint64_t steps()const{return largest.size() - 1;}
+
+    //expected size of the largest component (fraction of the vertices) when every vertex / edge is open with probability p
+    double largest_at(double p)const{return binomial_convolution(largest, p);}
+};
+
+struct graph_percolation_t{
+    graph_percolation_t(graph_t const& g, percolation_t kind) : n{g.vertices()}, kind{kind}{
+        assert(g.is_valid());
+        //the neighbours are scanned once per vertex and per sample: flat arrays instead of the sets
+        if(kind == percolation_t::site)
+            adjs = csr_graph_t{g};
+        else
+            for(uint64_t v=0; v<g.vertices(); ++v)
+                for(auto w : g.adj(v))
+                    if(v < w) es.emplace_back(v, w);
+    }
+
+    //number of steps of a sweep (vertices or edges)
+    uint64_t steps()const{return kind == percolation_t::site ? n : es.size();}
+
+    //the edges opened by a bond sweep (step i opens es[order[i]])
+    std::vector<std::pair<uint64_t, uint64_t>> const& edges()const{return es;}
+
+    //a random opening order (a permutation of the vertices or of the edges)
+    std::vector<uint64_t> order(uint64_t seed, uint64_t sample)const{
+        std::vector<uint64_t> o(steps());
+        std::iota(o.begin(), o.end(), 0);
+        std::seed_seq seq{seed, sample};
+        std::mt19937_64 gen{seq};
+        std::shuffle(o.begin(), o.end(), gen);
+        return o;
+    }
+
+    //opens everything in the given order, largest[n] = size of the largest component after n steps,
+    //returns the step where the largest component grew the most (the first one on ties)
+    uint64_t sweep(std::vector<uint64_t> const& order, std::vector<uint64_t>& largest)const{
+        assert(order.size() == steps());
+        union_find_weighted_quick_union_path_compression uf{n};
+        largest.assign(order.size() + 1, 0);
+        uint64_t best{0}, jump{0};
+        if(kind == percolation_t::site){
+            std::vector<char> open(n, 0);
+            for(uint64_t i=0; i<order.size(); ++i){
+                auto v = order[i];
+                open[v] = 1;
+                for(auto w : adjs.adj(v))
+                    if(open[w]) uf.connect(v, w);
+                largest[i+1] = std::max(largest[i], uf.size(v));
+                if(largest[i+1] - largest[i] > jump){
+                    jump = largest[i+1] - largest[i];
+                    best = i + 1;
+                }
+            }
+        }else{
+            largest[0] = n ? 1 : 0;
+            for(uint64_t i=0; i<order.size(); ++i){
+                auto& e = es[order[i]];
+                uf.connect(e.first, e.second);
+                largest[i+1] = std::max(largest[i], uf.size(e.first));
+                if(largest[i+1] - largest[i] > jump){
+                    jump = largest[i+1] - largest[i];
+                    best = i + 1;
+                }
+            }
+        }
+        return best;
+    }
+
+    //samples sweeps with independent random orders, on nthreads threads
+    percolation_curve_t run(uint64_t samples, uint64_t seed, uint64_t nthreads = 0)const{
+        nthreads = parallel::threads(nthreads);
+        uint64_t m{steps()};
+        //per thread sums of largest[n] (the threshold step of every sample is kept)
+        std::vector<std::vector<uint64_t>> sums(nthreads, std::vector<uint64_t>(m + 1, 0));
+        std::vector<uint64_t> jumps(samples, 0);
+        parallel::for_dynamic(samples, nthreads, 1, [&](uint64_t lo, uint64_t hi, uint64_t t){
+            std::vector<uint64_t> largest;
+            for(auto s=lo; s<hi; ++s){
+                jumps[s] = sweep(order(seed, s), largest);
+                for(uint64_t i=0; i<=m; ++i)
+                    sums[t][i] += largest[i];
+            }
+        });
+
+        percolation_curve_t curve{kind, n, samples, std::vector<double>(m + 1, 0), 0, 0};
+        for(uint64_t i=0; i<=m; ++i){
+            uint64_t total{0};
+            for(auto& s : sums) total += s[i];
+            curve.largest[i] = samples && n ? double(total) / samples / n : 0;
+        }
+        if(samples && m){
+            double mean{0}, var{0};
+            for(auto j : jumps) mean += double(j) / m;
+            mean /= samples;
+            for(auto j : jumps) var += (double(j) / m - mean) * (double(j) / m - mean);
+            curve.threshold = mean;
+            curve.threshold_error = samples > 1 ? std::sqrt(var / (samples - 1) / samples) : 0;
+        }
+        return curve;
+    }
+
+private:
+    uint64_t n;
+    percolation_t kind;
+    csr_graph_t adjs;
+    std::vector<std::pair<uint64_t, uint64_t>> es;
+};
+
+#endif//__GRAPH_PERCOLATION_H__
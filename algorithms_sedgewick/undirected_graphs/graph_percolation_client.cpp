@@ -0,0 +1,236 @@
+// to compile (e.g.): g++ -std=c++14 graph_percolation_client.cpp -O3 -pthread
+// to run (e.g.): ./a.out site 1000 [points] [seed] [threads] < datasets/mediumG.txt > curve.csv
+//      where site | bond: what is opened, 1000: number of samples, points: number of values of p in [0, 1]
+//      (default 101); output (csv): p,largest_component_fraction (the threshold and timings go to stderr)
+//   or: ./a.out check [N] [samples]
+//      on a NxN grid graph (default 64, 200 samples, N >= 1, samples >= 2) written as a dataset and read back as a graph_t:
+//      the same opening order as newman_ziff_simulation must give the same largest cluster after every
+//      step, a recount from scratch must agree, the curve must not depend on the number of threads and
+//      the site threshold must match the same estimator on newman_ziff_simulation's own sweeps, the bond
+//      threshold the same estimator on sweeps of the grid edges with a union-find of their own
+//      (percolation_experiment's spanning threshold and 0.5 for bond are only reported)
+
+#include "graph.h"
+#include "graph_percolation.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <string>
+
+#include <cstdlib>
+
+//the N x N grid (cell = line * N + column, as in percolation.h) in the format of the datasets
+std::string grid_dataset(uint64_t N){
+    std::ostringstream os;
+    os << N * N << '\n' << 2 * N * (N - 1) << '\n';
+    for(uint64_t l=0; l<N; ++l){
+        for(uint64_t c=0; c<N; ++c){
+            if(c + 1 < N) os << l * N + c << ' ' << l * N + c + 1 << '\n';
+            if(l + 1 < N) os << l * N + c << ' ' << (l + 1) * N + c << '\n';
+        }
+    }
+    return os.str();
+}
+
+//the largest component after the first k steps of order, from scratch
+uint64_t recount(graph_t const& g, graph_percolation_t const& gp, percolation_t kind, std::vector<uint64_t> const& order, uint64_t k){
+    union_find_weighted_quick_union_path_compression uf{g.vertices()};
+    uint64_t largest{0};
+    if(kind == percolation_t::site){
+        std::vector<char> open(g.vertices(), 0);
+        for(uint64_t i=0; i<k; ++i) open[order[i]] = 1;
+        for(uint64_t v=0; v<g.vertices(); ++v)
+            if(open[v])
+                for(auto w : g.adj(v))
+                    if(open[w]) uf.connect(v, w);
+        for(uint64_t v=0; v<g.vertices(); ++v)
+            if(open[v]) largest = std::max(largest, uf.size(v));
+    }else{
+        for(uint64_t i=0; i<k; ++i)
+            uf.connect(gp.edges()[order[i]].first, gp.edges()[order[i]].second);
+        for(uint64_t v=0; v<g.vertices(); ++v)
+            largest = std::max(largest, uf.size(v));
+    }
+    return largest;
+}
+
+//mean and standard error of sample(s), s = 0..samples-1
+template<typename F>
+std::pair<double, double> estimate(uint64_t samples, F&& sample){
+    double mean{0}, sq{0};
+    for(uint64_t s=0; s<samples; ++s){
+        double t = sample(s);
+        mean += t;
+        sq += t * t;
+    }
+    mean /= samples;
+    return {mean, std::sqrt(std::max(0.0, sq / samples - mean * mean) / (samples - 1))};
+}
+
+//the bond threshold estimator (largest jump of the largest component) on the N x N grid, sample s,
+//with the edges from the grid arithmetic and a union-find of its own (not graph_percolation_t)
+double grid_bond_threshold(uint64_t N, uint64_t s){
+    std::vector<std::pair<uint64_t, uint64_t>> es;
+    for(uint64_t l=0; l<N; ++l){
+        for(uint64_t c=0; c<N; ++c){
+            if(c + 1 < N) es.emplace_back(l * N + c, l * N + c + 1);
+            if(l + 1 < N) es.emplace_back(l * N + c, (l + 1) * N + c);
+        }
+    }
+    if(es.empty()) return 0;
+    std::mt19937_64 gen{1000003 * (s + 1)};
+    std::shuffle(es.begin(), es.end(), gen);
+    union_find_weighted_quick_union_path_compression uf{N * N};
+    uint64_t best{0}, jump{0}, previous{1};
+    for(uint64_t n=1; n<=es.size(); ++n){
+        uf.connect(es[n-1].first, es[n-1].second);
+        auto largest = std::max(previous, uf.size(es[n-1].first));
+        if(largest - previous > jump){
+            jump = largest - previous;
+            best = n;
+        }
+        previous = largest;
+    }
+    return double(best) / es.size();
+}
+
+bool check(uint64_t N, uint64_t samples){
+    graph_t grid;
+    std::istringstream is{grid_dataset(N)};
+    is >> grid;
+    std::cout << "grid graph: " << N << "x" << N << ", " << samples << " samples" << std::endl;
+
+    bool ok{true};
+    graph_percolation_t site{grid, percolation_t::site}, bond{grid, percolation_t::bond};
+
+    //the order of newman_ziff_simulation on the grid graph
+    bool same{true};
+    std::vector<uint64_t> largest;
+    for(int s=0; s<5; ++s){
+        newman_ziff_simulation nz{N};
+        site.sweep(nz.cells, largest);
+        for(uint64_t n=1; n<=N*N; ++n){
+            nz.open_next();
+            same = same && nz.largest == largest[n];
+        }
+    }
+    std::cout << "same order as newman_ziff_simulation: " << (same ? "ok" : "DIFFERENT") << std::endl;
+    ok = ok && same;
+
+    same = true;
+    for(auto gp : {&site, &bond}){
+        auto kind = gp == &site ? percolation_t::site : percolation_t::bond;
+        for(uint64_t s=0; s<3; ++s){
+            auto o = gp->order(7, s);
+            gp->sweep(o, largest);
+            for(uint64_t k : {o.size() / 4, o.size() / 2, o.size() * 3 / 4, o.size()})
+                same = same && recount(grid, *gp, kind, o, k) == largest[k];
+        }
+    }
+    std::cout << "recount from scratch: " << (same ? "ok" : "DIFFERENT") << std::endl;
+    ok = ok && same;
+
+    auto threads = std::max<uint64_t>(4, parallel::threads());
+    auto one = site.run(samples, 1, 1), many = site.run(samples, 1, threads);
+    same = one.largest == many.largest && one.threshold == many.threshold;
+    std::cout << "1 thread vs " << threads << " threads: " << (same ? "ok" : "DIFFERENT") << std::endl;
+    ok = ok && same;
+
+    //the same estimator (largest jump of the largest cluster) on the sweeps of newman_ziff_simulation,
+    //independent orders: the two means must agree within their errors (both have the finite size bias)
+    auto nz_site = estimate(samples, [N](uint64_t){
+        newman_ziff_simulation nz{N};
+        uint64_t best{0}, jump{0}, previous{0};
+        for(uint64_t n=1; n<=N*N; ++n){
+            nz.open_next();
+            if(nz.largest - previous > jump){
+                jump = nz.largest - previous;
+                best = n;
+            }
+            previous = nz.largest;
+        }
+        return double(best) / (N*N);
+    });
+    double tolerance = 4 * std::sqrt(nz_site.second * nz_site.second + many.threshold_error * many.threshold_error);
+    bool close = std::abs(many.threshold - nz_site.first) <= tolerance;
+
+    //bond: the same estimator on sweeps of the grid edges in independent orders
+    auto b = bond.run(samples, 1);
+    auto grid_bond = estimate(samples, [N](uint64_t s){return grid_bond_threshold(N, s);});
+    double bond_tolerance = 4 * std::sqrt(grid_bond.second * grid_bond.second + b.threshold_error * b.threshold_error);
+    bool bond_close = std::abs(b.threshold - grid_bond.first) <= bond_tolerance;
+
+    //for reference only: the spanning threshold of the grid (and the exact bond threshold) are the
+    //limits for large N, the largest jump is biased upwards on small grids
+    percolation_experiment pe{N, samples};
+    double spanning = pe.run();
+    std::cout << std::fixed << std::setprecision(4)
+              << "site threshold: " << many.threshold << " +- " << many.threshold_error
+              << ", newman_ziff_simulation: " << nz_site.first << " +- " << nz_site.second
+              << " (" << (close ? "ok" : "TOO FAR") << ", tolerance " << tolerance << ")" << std::endl
+              << "    spanning (percolation_experiment): " << spanning << std::endl
+              << "bond threshold: " << b.threshold << " +- " << b.threshold_error
+              << ", grid edges: " << grid_bond.first << " +- " << grid_bond.second
+              << " (" << (bond_close ? "ok" : "TOO FAR") << ", tolerance " << bond_tolerance << ")" << std::endl
+              << "    exact: 0.5" << std::endl;
+
+    return ok && close && bond_close;
+}
+
+int main(int argc, char** argv){
+    if(argc < 2){
+        std::cerr << "Invalid number of arguments" << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::string mode = argv[1];
+
+    if(mode == "check"){
+        if(argc > 4){
+            std::cerr << "Invalid number of arguments" << std::endl;
+            return EXIT_FAILURE;
+        }
+        uint64_t N = argc > 2 ? std::stoull(argv[2]) : 64;
+        uint64_t samples = argc > 3 ? std::stoull(argv[3]) : 200;
+        //the tolerances come from the standard errors, which need 2 samples
+        if(N == 0 || samples < 2){
+            std::cerr << "Invalid arguments" << std::endl;
+            return EXIT_FAILURE;
+        }
+        return check(N, samples) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    if((mode != "site" && mode != "bond") || argc < 3 || argc > 6){
+        std::cerr << "Invalid arguments" << std::endl;
+        return EXIT_FAILURE;
+    }
+    auto kind = mode == "site" ? percolation_t::site : percolation_t::bond;
+    uint64_t samples = std::stoull(argv[2]);
+    uint64_t points = std::max<uint64_t>(2, argc > 3 ? std::stoull(argv[3]) : 101);
+    uint64_t seed = argc > 4 ? std::stoull(argv[4]) : 1;
+    uint64_t nthreads = parallel::threads(argc > 5 ? std::stoull(argv[5]) : 0);
+
+    graph_t graph;
+    std::cin >> graph;
+
+    auto start = std::chrono::steady_clock::now();
+    graph_percolation_t gp{graph, kind};
+    auto curve = gp.run(samples, seed, nthreads);
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cerr << mode << " percolation, " << curve.steps() << " steps, " << samples << " samples, "
+              << nthreads << " threads: " << elapsed << "s" << std::endl
+              << "threshold (largest jump of the largest component): " << curve.threshold
+              << " +- " << curve.threshold_error << std::endl;
+
+    std::cout << "p,largest_component_fraction" << std::endl;
+    std::cout << std::fixed << std::setprecision(6);
+    for(uint64_t i=0; i<points; ++i){
+        double p = double(i) / (points - 1);
+        std::cout << p << "," << curve.largest_at(p) << '\n';
+    }
+
+    return EXIT_SUCCESS;
+}
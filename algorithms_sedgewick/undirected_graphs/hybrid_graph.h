@@ -0,0 +1,273 @@
+#ifndef __HYBRID_GRAPH_H__
+#define __HYBRID_GRAPH_H__
+
+#include "graph.h"
+#include "set_intersection.h"
+
+#include <algorithm>
+#include <iterator>
+
+//Read-only represenation with bitset rows for the dense vertices and sorted arrays for the others...
+
+/*
+
+A bitset row costs V/8 bytes whatever the degree, a sorted array of 32 bit ids costs 4 * degree(v):
+the row of v is a bitset when degree(v) >= threshold (by default V/32, where both cost the same, so the
+few hubs of a power-law graph get one; a small dense graph gets one for every vertex).
+
+                        edge between v and w?               common neighbours of v and w
+
+both sparse             log (min degree)                    merge / gallop (set_intersection.h)
+one dense               1                                   degree(sparse) bit tests
+both dense              1                                   V/64 and + popcount
+
+adj(v) is a sorted range in both cases (a scan of the set bits for a dense row), so the basic_*<G>
+algorithms run on it unchanged.
+
+*/
+
+namespace bitset_kernels{
+    uint64_t and_count(uint64_t const* a, uint64_t const* b, uint64_t nwords){
+        uint64_t n{0};
+        for(uint64_t i=0; i<nwords; ++i)
+            n += __builtin_popcountll(a[i] & b[i]);
+        return n;
+    }
+
+    using and_count_fn_t = uint64_t (*)(uint64_t const*, uint64_t const*, uint64_t);
+
+#if defined(__x86_64__) || defined(__i386__)
+    //the same loop with the popcnt instruction (the generic one is a few shifts and masks per word)
+    __attribute__((target("popcnt")))
+    uint64_t and_count_popcnt(uint64_t const* a, uint64_t const* b, uint64_t nwords){
+        uint64_t n{0};
+        for(uint64_t i=0; i<nwords; ++i)
+            n += uint64_t(__builtin_popcountll(a[i] & b[i]));
+        return n;
+    }
+
+    and_count_fn_t best_and_count(){
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("popcnt") ? and_count_popcnt : and_count;
+    }
+#else
+    //(the compiler picks the popcount instruction of the target, if it has one)
+    and_count_fn_t best_and_count(){return and_count;}
+#endif
+}
+
+struct hybrid_graph_t{
+    static constexpr uint32_t sparse = std::numeric_limits<uint32_t>::max();
+
+    //the neighbours of v in increasing order, from an array or from the set bits of a row
+    struct adj_iterator{
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = uint64_t;
+        using difference_type = std::ptrdiff_t;
+        using pointer = uint64_t const*;
+        using reference = uint64_t;
+
+        adj_iterator() = default;
+
+        //sparse row
+        explicit adj_iterator(uint32_t const* p) : p{p}{}
+
+        //dense row, at word i
+        adj_iterator(uint64_t const* words, uint64_t i, uint64_t nwords) : words{words}, i{i}, nwords{nwords}{
+            if(i < nwords){
+                bits = words[i];
+                skip();
+            }
+        }
+
+        uint64_t operator*()const{return words ? i * 64 + uint64_t(__builtin_ctzll(bits)) : *p;}
+
+        adj_iterator& operator++(){
+            if(words){
+                bits &= bits - 1;
+                skip();
+            }else
+                ++p;
+            return *this;
+        }
+        adj_iterator operator++(int){auto r = *this; ++(*this); return r;}
+
+        bool operator==(adj_iterator const& o)const{return p == o.p && i == o.i && bits == o.bits;}
+        bool operator!=(adj_iterator const& o)const{return !(*this == o);}
+
+    private:
+        //the next set bit (or the end: i == nwords, bits == 0)
+        void skip(){
+            while(!bits && ++i < nwords)
+                bits = words[i];
+        }
+
+        uint32_t const* p{nullptr};
+        uint64_t const* words{nullptr};
+        uint64_t i{0};
+        uint64_t nwords{0};
+        uint64_t bits{0};
+    };
+
+    struct adj_range{
+        adj_iterator begin()const{return first;}
+        adj_iterator end()const{return last;}
+
+        adj_iterator first;
+        adj_iterator last;
+    };
+
+    hybrid_graph_t() = default;
+
+    //a bitset row for the vertices with degree >= V/32 (no more memory than their sorted arrays)
+    explicit hybrid_graph_t(graph_t const& g) : hybrid_graph_t(g, std::max<uint64_t>(1, (g.vertices() + 31) / 32)){}
+
+    //a bitset row for the vertices with degree >= threshold (0: every vertex)
+    hybrid_graph_t(graph_t const& g, uint64_t threshold) : and_count{bitset_kernels::best_and_count()}{
+        assert(g.is_valid());
+        assert(g.vertices() < std::numeric_limits<uint32_t>::max());
+
+        uint64_t n{g.vertices()};
+        nwords = (n + 63) / 64;
+        row.assign(n, sparse);
+        offsets.reserve(n + 1);
+        for(uint64_t v=0; v<n; ++v){
+            offsets.push_back(targets.size());
+            uint64_t d{g.adj(v).size()};
+            maxdeg = std::max(maxdeg, d);
+            if(d >= threshold){
+                row[v] = uint32_t(dense_degree.size());
+                dense_degree.push_back(d);
+                words.resize(words.size() + nwords, 0);
+                auto r = words.data() + row[v] * nwords;
+                for(auto w : g.adj(v))
+                    r[w / 64] |= uint64_t(1) << (w % 64);
+            }else{
+                for(auto w : g.adj(v))
+                    targets.push_back(uint32_t(w));
+            }
+        }
+        offsets.push_back(targets.size());
+        targets.shrink_to_fit();
+        words.shrink_to_fit();
+        valid = true;
+    }
+
+    bool is_valid() const {return valid;}
+
+    //number or vertices
+    uint64_t vertices()const{
+        assert(valid);
+        return row.size();
+    }
+
+    //number of vertices with a bitset row
+    uint64_t dense_rows()const{return dense_degree.size();}
+
+    bool is_dense(uint64_t v)const{
+        assert(v < vertices());
+        return row[v] != sparse;
+    }
+
+    uint64_t degree(uint64_t v)const{
+        assert(valid);
+        assert(v < vertices());
+        return row[v] != sparse ? dense_degree[row[v]] : offsets[v+1] - offsets[v];
+    }
+
+    uint64_t max_degree()const{return maxdeg;}
+
+    //vertices adjancent to v (sorted)
+    adj_range adj(uint64_t v)const{
+        assert(valid);
+        assert(v < vertices());
+        if(row[v] != sparse){
+            auto r = bits(v);
+            return adj_range{adj_iterator{r, 0, nwords}, adj_iterator{r, nwords, nwords}};
+        }
+        return adj_range{adj_iterator{targets.data() + offsets[v]}, adj_iterator{targets.data() + offsets[v+1]}};
+    }
+
+    //is there an edge between v and w? (a bit test if any of them is dense)
+    bool has_edge(uint64_t v, uint64_t w)const{
+        assert(valid);
+        assert(v < vertices() && w < vertices());
+        if(row[v] != sparse) return test(bits(v), w);
+        if(row[w] != sparse) return test(bits(w), v);
+        auto dv = offsets[v+1] - offsets[v], dw = offsets[w+1] - offsets[w];
+        if(dw < dv) std::swap(v, w);
+        auto first = targets.data() + offsets[v], last = targets.data() + offsets[v+1];
+        return std::binary_search(first, last, uint32_t(w));
+    }
+
+    //number of common neighbours of v and w
+    uint64_t common(uint64_t v, uint64_t w, set_intersection::kernels_t const& kernels, std::vector<uint32_t>& buffer)const{
+        assert(valid);
+        assert(v < vertices() && w < vertices());
+        if(row[v] != sparse && row[w] != sparse)
+            return and_count(bits(v), bits(w), nwords);
+        if(row[v] != sparse || row[w] != sparse){
+            if(row[v] == sparse) std::swap(v, w);
+            auto r = bits(v);
+            uint64_t n{0};
+            for(auto p = targets.data() + offsets[w]; p != targets.data() + offsets[w+1]; ++p)
+                n += test(r, *p);
+            return n;
+        }
+        return intersect(v, w, kernels, buffer);
+    }
+
+    //the common neighbours of v and w, sorted, in buffer[0, returned value)
+    uint64_t intersect(uint64_t v, uint64_t w, set_intersection::kernels_t const& kernels, std::vector<uint32_t>& buffer)const{
+        assert(valid);
+        assert(v < vertices() && w < vertices());
+        buffer.resize(std::max<uint64_t>(buffer.size(), std::min(degree(v), degree(w))));
+        auto out = buffer.data();
+        uint64_t n{0};
+        if(row[v] != sparse && row[w] != sparse){
+            auto a = bits(v), b = bits(w);
+            for(uint64_t i=0; i<nwords; ++i)
+                for(auto m = a[i] & b[i]; m; m &= m - 1)
+                    out[n++] = uint32_t(i * 64 + uint64_t(__builtin_ctzll(m)));
+            return n;
+        }
+        if(row[v] != sparse || row[w] != sparse){
+            if(row[v] == sparse) std::swap(v, w);
+            auto r = bits(v);
+            for(auto p = targets.data() + offsets[w]; p != targets.data() + offsets[w+1]; ++p)
+                if(test(r, *p)) out[n++] = *p;
+            return n;
+        }
+        return kernels(targets.data() + offsets[v], offsets[v+1] - offsets[v],
+                       targets.data() + offsets[w], offsets[w+1] - offsets[w], out);
+    }
+
+    //memory used by the representation
+    uint64_t bytes()const{
+        return targets.size() * sizeof(uint32_t) + offsets.size() * sizeof(uint64_t) + row.size() * sizeof(uint32_t)
+             + words.size() * sizeof(uint64_t) + dense_degree.size() * sizeof(uint64_t);
+    }
+
+private:
+    uint64_t const* bits(uint64_t v)const{return words.data() + row[v] * nwords;}
+
+    static bool test(uint64_t const* r, uint64_t w){return (r[w / 64] >> (w % 64)) & 1;}
+
+    bool valid{false};
+    uint64_t maxdeg{0};
+    uint64_t nwords{0};
+    bitset_kernels::and_count_fn_t and_count{nullptr};
+
+    //row[v]: index of the bitset of v (or sparse)
+    std::vector<uint32_t> row;
+    //sparse rows: adj(v) is targets[offsets[v], offsets[v+1]) (empty for a dense row)
+    std::vector<uint64_t> offsets;
+    std::vector<uint32_t> targets;
+    //dense rows: the bitset r is words[r * nwords, (r+1) * nwords)
+    std::vector<uint64_t> words;
+    std::vector<uint64_t> dense_degree;
+};
+
+constexpr uint32_t hybrid_graph_t::sparse;
+
+#endif//__HYBRID_GRAPH_H__
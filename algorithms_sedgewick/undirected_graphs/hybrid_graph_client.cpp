@@ -0,0 +1,193 @@
+// to compile (e.g.): g++ -std=c++14 hybrid_graph_client.cpp -O3
+// to run (e.g.): ./a.out [threshold] [queries] < datasets/mediumG.txt
+//      where threshold: the degree from which a vertex gets a bitset row (default: V/32, 0: every vertex),
+//      queries: number of queries of each kind (default 1000000)
+
+// compares graph_t, csr_graph_t and hybrid_graph_t: memory, latency of has_edge (random pairs, pairs
+// with a hub, existing edges) and of counting common neighbours (pairs of hubs, existing edges);
+// all the answers, adj(v) of every vertex and bfs from a few sources must be the same
+
+#include "graph.h"
+#include "csr_graph.h"
+#include "hybrid_graph.h"
+#include "paths.h"
+
+#include <chrono>
+#include <iomanip>
+#include <memory>
+#include <random>
+#include <string>
+
+#include <cstdlib>
+
+template<typename F>
+double time_it(F&& f){
+    auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+using pairs_t = std::vector<std::pair<uint64_t, uint64_t>>;
+
+//a std::set node is 3 pointers, the color and the value (40 bytes, 48 with the malloc header)
+uint64_t set_graph_bytes(graph_t const& g){
+    uint64_t b{g.vertices() * sizeof(std::set<uint64_t>)};
+    for(uint64_t v=0; v<g.vertices(); ++v)
+        b += g.adj(v).size() * 48;
+    return b;
+}
+
+bool csr_has_edge(csr_graph_t const& g, uint64_t v, uint64_t w){
+    if(g.degree(w) < g.degree(v)) std::swap(v, w);
+    auto a = g.adj(v);
+    return std::binary_search(a.begin(), a.end(), uint32_t(w));
+}
+
+uint64_t set_common(graph_t const& g, uint64_t v, uint64_t w){
+    auto& a = g.adj(v).size() <= g.adj(w).size() ? g.adj(v) : g.adj(w);
+    auto& b = g.adj(v).size() <= g.adj(w).size() ? g.adj(w) : g.adj(v);
+    uint64_t n{0};
+    for(auto x : a)
+        n += b.count(x);
+    return n;
+}
+
+//the time of every representation on the same queries (per query), false if the answers differ
+template<typename SetF, typename CsrF, typename HybridF>
+bool compare(std::string const& name, pairs_t const& qs, SetF&& set_f, CsrF&& csr_f, HybridF&& hybrid_f){
+    std::vector<uint64_t> r0(qs.size()), r1(qs.size()), r2(qs.size());
+    double t0 = time_it([&]{for(uint64_t i=0; i<qs.size(); ++i) r0[i] = set_f(qs[i].first, qs[i].second);});
+    double t1 = time_it([&]{for(uint64_t i=0; i<qs.size(); ++i) r1[i] = csr_f(qs[i].first, qs[i].second);});
+    double t2 = time_it([&]{for(uint64_t i=0; i<qs.size(); ++i) r2[i] = hybrid_f(qs[i].first, qs[i].second);});
+    bool same = r0 == r1 && r0 == r2;
+    auto ns = [&qs](double t){return qs.empty() ? 0.0 : t / qs.size() * 1e9;};
+    std::cout << std::left << std::setw(28) << name << std::right << std::fixed << std::setprecision(1)
+              << std::setw(12) << ns(t0) << std::setw(12) << ns(t1) << std::setw(12) << ns(t2)
+              << (same ? "" : "   DIFFERENT ANSWERS") << std::endl;
+    return same;
+}
+
+int main(int argc, char** argv){
+    if(argc > 3){
+        std::cerr << "Invalid number of arguments" << std::endl;
+        return EXIT_FAILURE;
+    }
+    bool auto_threshold = argc < 2 || std::string(argv[1]) == "auto";
+    uint64_t threshold = auto_threshold ? 0 : std::stoull(argv[1]);
+    uint64_t nqueries = argc > 2 ? std::stoull(argv[2]) : 1000000;
+
+    graph_t graph;
+    std::cin >> graph;
+    uint64_t n{graph.vertices()};
+    if(n == 0)
+        return EXIT_SUCCESS;
+
+    csr_graph_t csr;
+    std::unique_ptr<hybrid_graph_t> hybrid;
+    double t_csr = time_it([&]{csr = csr_graph_t{graph};});
+    double t_hybrid = time_it([&]{
+        hybrid = auto_threshold ? std::make_unique<hybrid_graph_t>(graph) : std::make_unique<hybrid_graph_t>(graph, threshold);
+    });
+
+    std::cout << "Vertices: " << n << ", edges: " << csr.arcs() / 2 << ", max degree: " << csr.max_degree()
+              << ", bitset rows: " << hybrid->dense_rows() << std::endl
+              << "Memory: graph_t ~" << set_graph_bytes(graph) << " bytes, csr_graph_t " << csr.bytes()
+              << " bytes, hybrid_graph_t " << hybrid->bytes() << " bytes" << std::endl
+              << "Build: csr_graph_t " << t_csr << "s, hybrid_graph_t " << t_hybrid << "s" << std::endl;
+
+    //the same neighbours in the same order
+    bool ok{true};
+    for(uint64_t v=0; v<n && ok; ++v){
+        auto a = hybrid->adj(v);
+        ok = hybrid->degree(v) == graph.adj(v).size()
+          && uint64_t(std::distance(a.begin(), a.end())) == graph.adj(v).size()
+          && std::equal(a.begin(), a.end(), graph.adj(v).begin());
+    }
+    std::cout << "adj(v): " << (ok ? "same" : "DIFFERENT") << std::endl;
+
+    std::mt19937_64 gen{11};
+    std::uniform_int_distribution<uint64_t> pick{0, n - 1};
+    for(int s=0; s<3; ++s){
+        auto u = pick(gen);
+        bfs_paths_t expected{graph, u};
+        basic_bfs_paths_t<hybrid_graph_t> got{*hybrid, u};
+        bool same{true};
+        for(uint64_t v=0; v<n; ++v)
+            same = same && expected.connected_to(v) == got.connected_to(v)
+                        && (!expected.connected_to(v) || expected.distance_to(v) == got.distance_to(v));
+        std::cout << "bfs from " << u << ": " << (same ? "same" : "DIFFERENT") << std::endl;
+        ok = ok && same;
+    }
+
+    //the hubs: the bitset rows, or the 64 largest degrees when there are none
+    std::vector<uint64_t> hubs;
+    for(uint64_t v=0; v<n; ++v)
+        if(hybrid->is_dense(v)) hubs.push_back(v);
+    if(hubs.empty()){
+        std::vector<uint64_t> by_degree(n);
+        for(uint64_t v=0; v<n; ++v) by_degree[v] = v;
+        auto k = std::min<uint64_t>(64, n);
+        std::partial_sort(by_degree.begin(), by_degree.begin() + k, by_degree.end(), [&csr](uint64_t a, uint64_t b){
+            return csr.degree(a) > csr.degree(b);
+        });
+        hubs.assign(by_degree.begin(), by_degree.begin() + k);
+    }
+    std::uniform_int_distribution<uint64_t> pick_hub{0, hubs.size() - 1};
+
+    pairs_t random_pairs(nqueries), hub_pairs(nqueries), edges;
+    for(auto& q : random_pairs) q = {pick(gen), pick(gen)};
+    for(auto& q : hub_pairs) q = {hubs[pick_hub(gen)], pick(gen)};
+    //an end of a random arc: (v, w) with probability proportional to the degree of v
+    if(csr.arcs()){
+        std::uniform_int_distribution<uint64_t> pick_arc{0, csr.arcs() - 1};
+        std::vector<uint64_t> owner;
+        owner.reserve(csr.arcs());
+        for(uint64_t v=0; v<n; ++v)
+            owner.insert(owner.end(), csr.degree(v), v);
+        edges.resize(nqueries);
+        for(auto& q : edges){
+            auto v = owner[pick_arc(gen)];
+            std::uniform_int_distribution<uint64_t> pick_adj{0, csr.degree(v) - 1};
+            q = {v, csr.adj(v).begin()[pick_adj(gen)]};
+        }
+    }
+
+    std::cout << std::endl << std::left << std::setw(28) << "ns per query" << std::right
+              << std::setw(12) << "graph_t" << std::setw(12) << "csr" << std::setw(12) << "hybrid" << std::endl;
+
+    auto set_edge = [&graph](uint64_t v, uint64_t w){return graph.has_edge(v, w);};
+    auto csr_edge = [&csr](uint64_t v, uint64_t w){return csr_has_edge(csr, v, w);};
+    auto hybrid_edge = [&hybrid](uint64_t v, uint64_t w){return hybrid->has_edge(v, w);};
+    ok = compare("has_edge (random pairs)", random_pairs, set_edge, csr_edge, hybrid_edge) && ok;
+    ok = compare("has_edge (hub, random)", hub_pairs, set_edge, csr_edge, hybrid_edge) && ok;
+    ok = compare("has_edge (edges)", edges, set_edge, csr_edge, hybrid_edge) && ok;
+
+    //common neighbours are much slower, fewer queries
+    set_intersection::kernels_t kernels{intersection_t::simd};
+    std::vector<uint32_t> buffer(csr.max_degree());
+    pairs_t hub_hub(std::max<uint64_t>(1, nqueries / 100)), few_edges(edges.begin(), edges.begin() + std::min<uint64_t>(edges.size(), nqueries / 10));
+    for(auto& q : hub_hub) q = {hubs[pick_hub(gen)], hubs[pick_hub(gen)]};
+    auto set_common_f = [&graph](uint64_t v, uint64_t w){return set_common(graph, v, w);};
+    auto csr_common_f = [&](uint64_t v, uint64_t w){
+        auto a = csr.adj(v), b = csr.adj(w);
+        return kernels(a.begin(), a.size(), b.begin(), b.size(), buffer.data());
+    };
+    auto hybrid_common_f = [&](uint64_t v, uint64_t w){return hybrid->common(v, w, kernels, buffer);};
+    ok = compare("common (hub, hub)", hub_hub, set_common_f, csr_common_f, hybrid_common_f) && ok;
+    ok = compare("common (edges)", few_edges, set_common_f, csr_common_f, hybrid_common_f) && ok;
+
+    //intersect must list the same vertices as the csr kernels
+    uint64_t listed{0};
+    std::vector<uint32_t> expected(csr.max_degree());
+    for(auto& q : hub_hub){
+        auto a = csr.adj(q.first), b = csr.adj(q.second);
+        auto k = kernels(a.begin(), a.size(), b.begin(), b.size(), expected.data());
+        auto m = hybrid->intersect(q.first, q.second, kernels, buffer);
+        listed += k;
+        ok = ok && k == m && std::equal(expected.begin(), expected.begin() + k, buffer.begin());
+    }
+    std::cout << std::endl << "intersect: " << listed << " common neighbours listed" << std::endl
+              << (ok ? "all the answers are the same" : "DIFFERENT ANSWERS") << std::endl;
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
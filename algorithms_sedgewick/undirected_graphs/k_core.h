@@ -0,0 +1,196 @@
+#ifndef __K_CORE_H__
+#define __K_CORE_H__
+
+#include "graph.h"
+#include "csr_graph.h"
+#include "parallel.h"
+
+#include <atomic>
+#include <memory>
+
+//k-core decomposition...
+
+/*
+
+k-core              the largest subgraph in which every vertex has at least k neighbours
+core number of v    the largest k such that v is in the k-core
+degeneracy          the largest core number
+
+Both algorithms peel the graph: remove the vertices of degree <= k (their core number is k), update the
+degrees of their neighbours, repeat while there is something to remove, then move to k+1.
+
+    Batagelj-Zaversnik  one vertex at a time, the vertices are kept sorted by degree with a bucket sort
+                        (O(E+V), sequential)
+    level synchronous   every round removes the whole frontier (all the vertices of degree <= k) in parallel,
+                        the degrees are atomic and the thread whose decrement takes a neighbour from k+1 to k
+                        puts it in the next frontier (so every vertex is claimed exactly once)
+
+*/
+
+struct k_core_t{
+    k_core_t(graph_t const& g) : g{g}{assert(g.is_valid());}
+
+    //just to force this type to be only base class
+    virtual ~k_core_t() = 0;
+
+    //core number of v
+    uint64_t core(uint64_t v)const{
+        assert(v < cores.size());
+        return cores[v];
+    }
+
+    //largest core number
+    uint64_t degeneracy()const{return kmax;}
+
+    //number of vertices in the k-core
+    uint64_t size(uint64_t k)const{
+        return std::count_if(cores.begin(), cores.end(), [k](uint32_t c){return c >= k;});
+    }
+
+protected:
+    void finish(){
+        kmax = cores.empty() ? 0 : *std::max_element(cores.begin(), cores.end());
+    }
+
+    graph_t const& g;
+    std::vector<uint32_t> cores;
+    uint64_t kmax{0};
+};
+
+k_core_t::~k_core_t(){};
+
+struct bz_k_core_t : public k_core_t{
+    bz_k_core_t(graph_t const& g) : k_core_t(g){
+        uint64_t n{g.vertices()};
+        std::vector<uint64_t> deg(n), pos(n), vert(n);
+        uint64_t md{0};
+        for(uint64_t v=0; v<n; ++v){
+            deg[v] = g.adj(v).size();
+            md = std::max(md, deg[v]);
+        }
+
+        //bin[d] = first position of the vertices of degree d in vert
+        std::vector<uint64_t> bin(md+1, 0);
+        for(uint64_t v=0; v<n; ++v) ++bin[deg[v]];
+        for(uint64_t d=0, start=0; d<=md; ++d){
+            auto num = bin[d];
+            bin[d] = start;
+            start += num;
+        }
+        for(uint64_t v=0; v<n; ++v){
+            pos[v] = bin[deg[v]]++;
+            vert[pos[v]] = v;
+        }
+        for(uint64_t d=md; d>0; --d) bin[d] = bin[d-1];
+        bin[0] = 0;
+
+        for(uint64_t i=0; i<n; ++i){
+            auto v = vert[i];
+            for(auto u : g.adj(v)){
+                if(deg[u] <= deg[v]) continue;
+                //swap u with the first vertex of its bin, then move the bin boundary over it
+                auto du = deg[u], pu = pos[u], pw = bin[du];
+                auto w = vert[pw];
+                if(u != w){
+                    pos[u] = pw; vert[pu] = w;
+                    pos[w] = pu; vert[pw] = u;
+                }
+                ++bin[du];
+                --deg[u];
+            }
+        }
+
+        cores.assign(deg.begin(), deg.end());
+        finish();
+    }
+};
+
+struct peeling_k_core_t : public k_core_t{
+    static constexpr uint32_t none = std::numeric_limits<uint32_t>::max();
+
+    peeling_k_core_t(graph_t const& g, uint64_t nthreads = 0)
+        : k_core_t(g), csr{g}, nthreads{parallel::threads(nthreads)}
+    {
+        uint64_t n{csr.vertices()};
+        auto deg = std::make_unique<std::atomic<uint32_t>[]>(n);
+        cores.assign(n, none);
+        std::vector<uint32_t> remaining(n);
+        for(uint64_t v=0; v<n; ++v){
+            deg[v].store(uint32_t(csr.degree(v)), std::memory_order_relaxed);
+            remaining[v] = uint32_t(v);
+        }
+
+        std::vector<std::vector<uint32_t>> local(this->nthreads);
+        auto gather = [&local](std::vector<uint32_t>& out){
+            out.clear();
+            for(auto& l : local){
+                out.insert(out.end(), l.begin(), l.end());
+                l.clear();
+            }
+        };
+
+        std::vector<uint32_t> frontier, kept;
+        uint64_t k{0};
+        while(!remaining.empty()){
+            //the vertices already at degree <= k start the level, the others are kept for later
+            std::vector<uint64_t> min_deg(this->nthreads, none);
+            parallel::for_chunks(remaining.size(), this->nthreads, [&](uint64_t lo, uint64_t hi, uint64_t t){
+                for(auto i=lo; i<hi; ++i){
+                    auto v = remaining[i];
+                    if(cores[v] != none) continue;
+                    auto d = deg[v].load(std::memory_order_relaxed);
+                    if(d <= k){
+                        cores[v] = uint32_t(k);
+                        local[t].push_back(v);
+                    }else{
+                        min_deg[t] = std::min<uint64_t>(min_deg[t], d);
+                    }
+                }
+            });
+            gather(frontier);
+
+            if(frontier.empty()){
+                //nothing at this level: jump to the smallest degree left
+                k = *std::min_element(min_deg.begin(), min_deg.end());
+                continue;
+            }
+
+            while(!frontier.empty()){
+                ++levels;
+                parallel::for_dynamic(frontier.size(), this->nthreads, 256, [&](uint64_t lo, uint64_t hi, uint64_t t){
+                    for(auto i=lo; i<hi; ++i){
+                        for(auto w : csr.adj(frontier[i])){
+                            //only the decrement from k+1 claims w, the vertices already removed
+                            //(or in this frontier) are below k+1 and stay there
+                            if(deg[w].fetch_sub(1, std::memory_order_relaxed) == k + 1){
+                                cores[w] = uint32_t(k);
+                                local[t].push_back(w);
+                            }
+                        }
+                    }
+                });
+                gather(frontier);
+            }
+
+            kept.clear();
+            for(auto v : remaining)
+                if(cores[v] == none) kept.push_back(v);
+            std::swap(remaining, kept);
+            ++k;
+        }
+
+        finish();
+    }
+
+    //number of parallel rounds
+    uint64_t rounds()const{return levels;}
+
+private:
+    csr_graph_t csr;
+    uint64_t nthreads;
+    uint64_t levels{0};
+};
+
+constexpr uint32_t peeling_k_core_t::none;
+
+#endif//__K_CORE_H__
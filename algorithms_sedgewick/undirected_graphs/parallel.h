@@ -0,0 +1,77 @@
+#ifndef __PARALLEL_H__
+#define __PARALLEL_H__
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <cstdint>
+
+namespace parallel{
+    //number of threads to use when the caller does not care (0 = all the cores)
+    uint64_t threads(uint64_t requested = 0){
+        if(requested) return requested;
+        return std::max<uint64_t>(1, std::thread::hardware_concurrency());
+    }
+
+    //splits [0, n) in nthreads contiguous chunks, fn(lo, hi, thread_id) runs once per chunk
+    template<typename F>
+    void for_chunks(uint64_t n, uint64_t nthreads, F&& fn){
+        nthreads = std::max<uint64_t>(1, std::min(nthreads, n));
+        if(nthreads == 1){
+            fn(uint64_t{0}, n, uint64_t{0});
+            return;
+        }
+        std::vector<std::thread> workers;
+        for(uint64_t t=0; t<nthreads; ++t)
+            workers.emplace_back([&fn, n, nthreads, t]{fn(t * n / nthreads, (t+1) * n / nthreads, t);});
+        for(auto& w : workers)
+            w.join();
+    }
+
+    //dynamic scheduling for skewed work: the threads take chunks of `grain` items from a shared
+    //counter until [0, n) is exhausted, fn(lo, hi, thread_id) runs once per chunk
+    template<typename F>
+    void for_dynamic(uint64_t n, uint64_t nthreads, uint64_t grain, F&& fn){
+        grain = std::max<uint64_t>(1, grain);
+        nthreads = std::max<uint64_t>(1, std::min(nthreads, (n + grain - 1) / grain));
+        std::atomic<uint64_t> next{0};
+        auto work = [&fn, &next, n, grain](uint64_t t){
+            for(auto lo = next.fetch_add(grain); lo < n; lo = next.fetch_add(grain))
+                fn(lo, std::min(n, lo + grain), t);
+        };
+        if(nthreads == 1){
+            work(0);
+            return;
+        }
+        std::vector<std::thread> workers;
+        for(uint64_t t=0; t<nthreads; ++t)
+            workers.emplace_back(work, t);
+        for(auto& w : workers)
+            w.join();
+    }
+
+    //sorts the chunks of [first, last) in parallel, then merges them pairwise (log(nthreads) rounds)
+    template<typename It, typename Cmp>
+    void sort(It first, It last, Cmp cmp, uint64_t nthreads){
+        uint64_t n = uint64_t(last - first);
+        //not worth a thread below a few thousand elements
+        nthreads = std::max<uint64_t>(1, std::min(nthreads, n / 4096));
+        for_chunks(n, nthreads, [&](uint64_t lo, uint64_t hi, uint64_t){std::sort(first + lo, first + hi, cmp);});
+
+        //chunk t is [t * n / nthreads, (t+1) * n / nthreads), same as for_chunks
+        auto bound = [n, nthreads](uint64_t t){return std::min(t, nthreads) * n / nthreads;};
+        for(uint64_t width=1; width<nthreads; width*=2){
+            uint64_t merges = (nthreads + 2*width - 1) / (2*width);
+            for_chunks(merges, merges, [&](uint64_t lo, uint64_t hi, uint64_t){
+                for(auto m=lo; m<hi; ++m){
+                    auto t = m * 2 * width;
+                    if(t + width < nthreads)
+                        std::inplace_merge(first + bound(t), first + bound(t + width), first + bound(t + 2*width), cmp);
+                }
+            });
+        }
+    }
+}
+
+#endif//__PARALLEL_H__
@@ -0,0 +1,355 @@
+#ifndef __PARTITIONED_COMPS_H__
+#define __PARTITIONED_COMPS_H__
+
+#include "graph.h"
+#include "../union_find/uf_impl.h"
+
+#include <algorithm>
+#include <functional>
+#include <unordered_map>
+
+#include <cerrno>
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+//Connected components computed by K workers, each one owning a slice of the vertices...
+
+/*
+
+1. worker k owns the vertices [lo_k, hi_k) and their edges; an edge going to a vertex owned by
+   somebody else makes that vertex a ghost (a local copy of a remote vertex)
+2. every worker runs a local union-find (wqupc) over its owned vertices + ghosts and labels every
+   local component with the smallest vertex id it contains
+3. label exchange rounds: for every ghost whose label changed, the worker sends (ghost, label) to
+   the owner of the ghost, which keeps the smaller of the two labels for its own component;
+   the exchange stops when a round carries no message
+4. at the fixed point every component is labeled with its smallest vertex, so numbering the labels
+   in increasing order gives exactly the ids of connected_comps_t (which numbers the components in
+   the order of their first/smallest vertex)
+
+The workers never talk directly, every round goes through the coordinator (a star, BSP style):
+    workers -> coordinator: [n_0, (w, l) * n_0, n_1, ..., n_K-1, ...]   (pairs for each destination)
+    coordinator -> worker:  [continue, (w, l) ...]                      (pairs for that worker)
+
+*/
+
+//a message is just a bunch of numbers
+using message_t = std::vector<uint64_t>;
+
+//the channels between the coordinator and the workers + the way the workers are started
+struct transport_t{
+    virtual ~transport_t(){}
+
+    //number of workers
+    virtual uint64_t workers()const = 0;
+
+    //starts the K workers, worker k runs fn(k)
+    virtual void launch(std::function<void(uint64_t)> fn) = 0;
+    //waits for all the workers to finish
+    virtual void wait() = 0;
+
+    //used by the workers
+    virtual void send_to_coordinator(uint64_t k, message_t const& msg) = 0;
+    virtual message_t recv_from_coordinator(uint64_t k) = 0;
+
+    //used by the coordinator
+    virtual void send_to_worker(uint64_t k, message_t const& msg) = 0;
+    virtual message_t recv_from_worker(uint64_t k) = 0;
+
+    virtual std::string name()const = 0;
+};
+
+//one process per worker (fork), one unix socket pair between the coordinator and every worker
+struct socket_transport_t : public transport_t{
+    socket_transport_t(uint64_t K) : K{K}{
+        for(uint64_t k=0; k<K; ++k){
+            int sv[2];
+            if(socketpair(AF_UNIX, SOCK_STREAM, 0, sv) != 0)
+                throw std::runtime_error(std::string("socketpair: ") + std::strerror(errno));
+            coordinator_fds.push_back(sv[0]);
+            worker_fds.push_back(sv[1]);
+        }
+    }
+
+    ~socket_transport_t(){
+        for(auto fd : coordinator_fds) if(fd >= 0) close(fd);
+        for(auto fd : worker_fds) if(fd >= 0) close(fd);
+    }
+
+    uint64_t workers()const override {return K;}
+
+    std::string name()const override {return "unix sockets";}
+
+    void launch(std::function<void(uint64_t)> fn) override {
+        //do not let the children inherit (and flush) the buffered output
+        std::cout.flush();
+        std::cerr.flush();
+
+        for(uint64_t k=0; k<K; ++k){
+            pid_t pid = fork();
+            if(pid < 0)
+                throw std::runtime_error(std::string("fork: ") + std::strerror(errno));
+            if(pid == 0){
+                //the worker keeps only its own end
+                for(uint64_t j=0; j<K; ++j){
+                    close(coordinator_fds[j]);
+                    if(j != k) close(worker_fds[j]);
+                }
+                int status = EXIT_SUCCESS;
+                try{
+                    fn(k);
+                }catch(std::exception const& e){
+                    std::cerr << "worker " << k << ": " << e.what() << std::endl;
+                    status = EXIT_FAILURE;
+                }
+                _exit(status);
+            }
+            pids.push_back(pid);
+        }
+
+        for(auto& fd : worker_fds){close(fd); fd = -1;}
+    }
+
+    void wait() override {
+        bool ok{true};
+        for(auto pid : pids){
+            int status{0};
+            if(waitpid(pid, &status, 0) != pid || !WIFEXITED(status) || WEXITSTATUS(status) != EXIT_SUCCESS)
+                ok = false;
+        }
+        pids.clear();
+        if(!ok)
+            throw std::runtime_error("a worker failed");
+    }
+
+    void send_to_coordinator(uint64_t k, message_t const& msg) override {send(worker_fds[k], msg);}
+    message_t recv_from_coordinator(uint64_t k) override {return recv(worker_fds[k]);}
+
+    void send_to_worker(uint64_t k, message_t const& msg) override {send(coordinator_fds[k], msg);}
+    message_t recv_from_worker(uint64_t k) override {return recv(coordinator_fds[k]);}
+
+private:
+    //a message on the wire: its size followed by its content
+    static void send(int fd, message_t const& msg){
+        uint64_t n{msg.size()};
+        write_all(fd, &n, sizeof(n));
+        write_all(fd, msg.data(), n * sizeof(uint64_t));
+    }
+
+    static message_t recv(int fd){
+        uint64_t n{0};
+        read_all(fd, &n, sizeof(n));
+        message_t msg(n);
+        read_all(fd, msg.data(), n * sizeof(uint64_t));
+        return msg;
+    }
+
+    static void write_all(int fd, void const* buf, size_t sz){
+        auto p = static_cast<char const*>(buf);
+        while(sz > 0){
+            auto n = ::write(fd, p, sz);
+            if(n < 0 && errno == EINTR) continue;
+            if(n <= 0)
+                throw std::runtime_error(std::string("write: ") + std::strerror(errno));
+            p += n; sz -= n;
+        }
+    }
+
+    static void read_all(int fd, void* buf, size_t sz){
+        auto p = static_cast<char*>(buf);
+        while(sz > 0){
+            auto n = ::read(fd, p, sz);
+            if(n < 0 && errno == EINTR) continue;
+            if(n <= 0)
+                throw std::runtime_error(n == 0 ? std::string("read: connection closed") : std::string("read: ") + std::strerror(errno));
+            p += n; sz -= n;
+        }
+    }
+
+    uint64_t K;
+    std::vector<int> coordinator_fds;
+    std::vector<int> worker_fds;
+    std::vector<pid_t> pids;
+};
+
+struct partitioned_comps_t{
+    //finds the list of connected components using the K workers of the transport
+    partitioned_comps_t(graph_t const& g, transport_t& t) : g{g}, t{t}, K{t.workers()}{
+        assert(g.is_valid() && K > 0);
+
+        for(uint64_t k=0; k<=K; ++k)
+            bounds.push_back(k * g.vertices() / K);
+
+        t.launch([this](uint64_t k){worker(k);});
+        coordinator();
+        t.wait();
+    }
+
+    //is v connected to w?
+    bool connected(uint64_t v, uint64_t w)const{
+        assert(v != w);
+        assert(v < g.vertices());
+        assert(w < g.vertices());
+        return cc[v] == cc[w];
+    };
+
+    //returns the connected component id associated to v (same ids as connected_comps_t)
+    uint64_t id(uint64_t v)const{
+        assert(v < g.vertices());
+        return cc[v];
+    }
+
+    //returns the total number of connected components
+    uint64_t count()const{return ncc;}
+
+    //communication stats
+    uint64_t rounds()const{return nrounds;}         //label exchange rounds (the ones carrying messages)
+    uint64_t messages()const{return nmessages;}     //messages between the coordinator and the workers
+    uint64_t bytes()const{return nbytes;}           //payload of those messages
+    uint64_t labels_exchanged()const{return nlabels;}
+
+private:
+    uint64_t owner(uint64_t v)const{
+        return std::upper_bound(bounds.begin(), bounds.end(), v) - bounds.begin() - 1;
+    }
+
+    //runs in the worker process, it reads only the adjacency of the owned vertices
+    void worker(uint64_t k){
+        uint64_t lo{bounds[k]}, hi{bounds[k+1]};
+
+        //local ids: [0, hi-lo) for the owned vertices, then the ghosts
+        std::unordered_map<uint64_t, uint64_t> ghost_to_local;
+        std::vector<uint64_t> ghosts;
+        auto local = [&](uint64_t w){
+            if(w >= lo && w < hi)
+                return w - lo;
+            auto it = ghost_to_local.find(w);
+            if(it != ghost_to_local.end())
+                return it->second;
+            ghosts.push_back(w);
+            return ghost_to_local[w] = hi - lo + ghosts.size() - 1;
+        };
+        auto global = [&](uint64_t i){return i < hi - lo ? lo + i : ghosts[i - (hi - lo)];};
+
+        for(uint64_t v=lo; v<hi; ++v)
+            for(auto w : g.adj(v))
+                local(w);
+
+        uint64_t n{hi - lo + ghosts.size()};
+        union_find_weighted_quick_union_path_compression uf{n};
+        for(uint64_t v=lo; v<hi; ++v)
+            for(auto w : g.adj(v))
+                uf.connect(v - lo, local(w));
+
+        //every local component gets the smallest vertex it contains
+        std::vector<uint64_t> label(n, infinity);
+        for(uint64_t i=0; i<n; ++i){
+            auto r = uf.find(i);
+            label[r] = std::min(label[r], global(i));
+        }
+
+        //initially every ghost has something to say
+        std::vector<bool> dirty(n, true);
+        while(true){
+            std::vector<message_t> out(K);
+            for(uint64_t j=0; j<ghosts.size(); ++j){
+                auto r = uf.find(hi - lo + j);
+                if(dirty[r]){
+                    auto& o = out[owner(ghosts[j])];
+                    o.push_back(ghosts[j]);
+                    o.push_back(label[r]);
+                }
+            }
+            std::fill(dirty.begin(), dirty.end(), false);
+
+            message_t msg;
+            for(auto& o : out){
+                msg.push_back(o.size() / 2);
+                msg.insert(msg.end(), o.begin(), o.end());
+            }
+            t.send_to_coordinator(k, msg);
+
+            auto in = t.recv_from_coordinator(k);
+            if(!in[0])
+                break;
+            for(uint64_t i=1; i+1<in.size(); i+=2){
+                auto r = uf.find(in[i] - lo);
+                if(in[i+1] < label[r]){
+                    label[r] = in[i+1];
+                    dirty[r] = true;
+                }
+            }
+        }
+
+        //the final labels of the owned vertices
+        message_t labels(hi - lo);
+        for(uint64_t v=lo; v<hi; ++v)
+            labels[v - lo] = label[uf.find(v - lo)];
+        t.send_to_coordinator(k, labels);
+    }
+
+    void coordinator(){
+        auto account = [this](message_t const& msg){
+            ++nmessages;
+            nbytes += (msg.size() + 1) * sizeof(uint64_t);
+        };
+
+        while(true){
+            std::vector<message_t> in(K, message_t{1});
+            uint64_t pairs{0};
+            for(uint64_t k=0; k<K; ++k){
+                auto msg = t.recv_from_worker(k);
+                account(msg);
+                for(uint64_t j=0, i=0; j<K; ++j){
+                    auto n = msg[i++];
+                    in[j].insert(in[j].end(), msg.begin()+i, msg.begin()+i+2*n);
+                    i += 2*n;
+                    pairs += n;
+                }
+            }
+
+            //no label changed anywhere => fixed point
+            for(auto& msg : in){
+                msg[0] = pairs > 0;
+                account(msg);
+            }
+            for(uint64_t k=0; k<K; ++k)
+                t.send_to_worker(k, in[k]);
+
+            if(!pairs)
+                break;
+            ++nrounds;
+            nlabels += pairs;
+        }
+
+        std::vector<uint64_t> label;
+        for(uint64_t k=0; k<K; ++k){
+            auto msg = t.recv_from_worker(k);
+            account(msg);
+            label.insert(label.end(), msg.begin(), msg.end());
+        }
+
+        //label[v] is the smallest vertex of v's component, so label[v] <= v
+        cc.resize(g.vertices(), infinity);
+        for(uint64_t v=0; v<g.vertices(); ++v)
+            cc[v] = label[v] == v ? ncc++ : cc[label[v]];
+    }
+
+    graph_t const& g;
+    transport_t& t;
+    uint64_t K;
+    std::vector<uint64_t> bounds;
+
+    std::vector<uint64_t> cc;
+    uint64_t ncc{0};
+
+    uint64_t nrounds{0};
+    uint64_t nmessages{0};
+    uint64_t nbytes{0};
+    uint64_t nlabels{0};
+};
+
+#endif//__PARTITIONED_COMPS_H__
@@ -0,0 +1,64 @@
+// to compile (e.g.): g++ -std=c++14 partitioned_comps_client.cpp -O3
+// to run (e.g.): ./a.out 4 < datasets/mediumG.txt
+//      where 4: the number of worker processes (default 2)
+
+// the output is the same as the one of basic_connected_comps_client.cpp
+// (the communication stats go to stderr), so the following command should return 0:
+// ./a.out 4 < datasets/mediumG.txt 2>/dev/null | diff - <(./basic_cc < datasets/mediumG.txt) | wc -l
+
+#include "graph.h"
+#include "connected_comps.h"
+#include "partitioned_comps.h"
+
+#include <string>
+
+#include <cstdlib>
+
+int main(int argc, char** argv){
+    if(argc != 1 && argc != 2){
+        std::cerr << "Invalid number of arguments" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    uint64_t K = 2;
+    if(argc == 2) K = std::stoull(argv[1]);
+    if(K == 0){
+        std::cerr << "Invalid arguments" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    graph_t graph;
+    std::cin >> graph;
+
+    socket_transport_t transport{K};
+    partitioned_comps_t cc{graph, transport};
+
+    std::cout << "Number of connected components: " << cc.count() << std::endl;
+
+    std::vector<std::vector<uint64_t>> components{cc.count()};
+    for(uint64_t v = 0; v<graph.vertices(); ++v){
+        components[cc.id(v)].push_back(v);
+    }
+
+    for(uint64_t c = 0; c<components.size(); ++c){
+        std::cout << "Component " << c << ": ";
+        for(uint64_t v = 0; v<components[c].size(); ++v)
+            std::cout << components[c][v] << " ";
+        std::cout << std::endl;
+    }
+
+    std::cerr << "Workers: " << K << " (" << transport.name() << ")" << std::endl;
+    std::cerr << "Rounds: " << cc.rounds() << std::endl;
+    std::cerr << "Messages: " << cc.messages() << std::endl;
+    std::cerr << "Bytes: " << cc.bytes() << std::endl;
+    std::cerr << "Labels exchanged: " << cc.labels_exchanged() << std::endl;
+
+    //must match the single process version exactly
+    connected_comps_t reference{graph};
+    bool same = reference.count() == cc.count();
+    for(uint64_t v = 0; same && v<graph.vertices(); ++v)
+        same = reference.id(v) == cc.id(v);
+    std::cerr << "Matches connected_comps_t: " << (same ? "yes" : "no") << std::endl;
+
+    return same ? EXIT_SUCCESS : EXIT_FAILURE;
+}
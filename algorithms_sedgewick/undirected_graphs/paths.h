@@ -2,15 +2,22 @@
 #define __PATHS_H__
 
 #include "graph.h"
+#include "traversal_stats.h"
 
 #include <stack>
 #include <queue>
 #include <deque>
+#include <iterator>
+#include <utility>
 
-struct paths_t{
+//the path finders are written against the graph interface (is_valid, vertices, adj)
+//so they run unchanged on graph_t or on any other read-only representation (e.g. compressed_graph_t)
+
+template<typename G>
+struct basic_paths_t{
     //finds paths in g from v to all connected vertices
     //takes time proportional to E+V as both DFS and BFS take time proportional to E+V
-    paths_t(graph_t const& g, uint64_t v) : g{g}, v{v}{
+    basic_paths_t(G const& g, uint64_t v) : g{g}, v{v}{
         assert(g.is_valid() && v<g.vertices());
 
         marked.resize(g.vertices(), false);
@@ -20,7 +27,7 @@ struct paths_t{
     }
 
     //just to force this type to be only base class
-    virtual ~paths_t() = 0;
+    virtual ~basic_paths_t() = 0;
 
     //is there a path from v to w?
     bool connected_to(uint64_t w)const{
@@ -37,6 +44,7 @@ struct paths_t{
     //returns the path from vertex v to vertex w
     std::deque<uint64_t> const path_to(uint64_t w)const{
         assert(connected_to(w));
+        auto timer = st.phase("path_reconstruction");
         std::deque<uint64_t> path;
         do{
             path.push_front(w);
@@ -45,25 +53,89 @@ struct paths_t{
         return path;
     }
 
+    //writes the path from vertex v to vertex w in the caller's buffer
+    //(it does not allocate once the buffer is large enough, so the same buffer can serve many queries)
+    void path_to(uint64_t w, std::vector<uint64_t>& path)const{
+        assert(connected_to(w));
+        auto timer = st.phase("path_reconstruction");
+        //the path has dist_to[w]+1 vertices, so it can be filled backwards
+        path.resize(dist_to[w]+1);
+        for(auto it = path.rbegin(); it != path.rend(); ++it){
+            *it = w;
+            w = edge_to[w];
+        }
+    }
+
+    //lazy view of the path from vertex w back to vertex v (walks edge_to while iterating)
+    struct reverse_path_t{
+        struct iterator{
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = uint64_t;
+            using difference_type = std::ptrdiff_t;
+            using pointer = uint64_t const*;
+            using reference = uint64_t const&;
+
+            uint64_t const& operator*()const{return w;}
+            iterator& operator++(){w = (*edge_to)[w]; return *this;}
+            iterator operator++(int){auto it = *this; ++*this; return it;}
+            bool operator==(iterator const& o)const{return w == o.w;}
+            bool operator!=(iterator const& o)const{return w != o.w;}
+
+            std::vector<uint64_t> const* edge_to;
+            uint64_t w;
+        };
+
+        iterator begin()const{return iterator{edge_to, w};}
+        iterator end()const{return iterator{edge_to, infinity};}
+        uint64_t size()const{return length;}
+
+        std::vector<uint64_t> const* edge_to;
+        uint64_t w;
+        uint64_t length;
+    };
+
+    reverse_path_t reverse_path_to(uint64_t w)const{
+        assert(connected_to(w));
+        return reverse_path_t{&edge_to, w, dist_to[w]+1};
+    }
+
+    //what the traversal did (empty unless compiled with -DSTATS)
+    traversal_stats_t const& stats()const{return st;}
+
 protected:
-    graph_t const& g;
+    G const& g;
     uint64_t const v;
 
+    mutable traversal_stats_t st;
+
     std::vector<bool> marked;
     std::vector<uint64_t> edge_to;
     std::vector<uint64_t> dist_to;
 };
 
-paths_t::~paths_t(){};
+template<typename G>
+basic_paths_t<G>::~basic_paths_t(){};
 
 //DFSRec
-struct dfs_rec_paths_t : public paths_t{
-    dfs_rec_paths_t(graph_t const& g, uint64_t v) : paths_t(g,v) {algo(v);}
+template<typename G>
+struct basic_dfs_rec_paths_t : public basic_paths_t<G>{
+    basic_dfs_rec_paths_t(G const& g, uint64_t v) : basic_paths_t<G>(g,v) {
+        auto timer = st.phase("traversal");
+        algo(v);
+    }
 
 private:
+    using basic_paths_t<G>::g;
+    using basic_paths_t<G>::marked;
+    using basic_paths_t<G>::edge_to;
+    using basic_paths_t<G>::dist_to;
+    using basic_paths_t<G>::st;
+
     void algo(uint64_t v){
         marked[v] = true;
+        st.visit(); st.level(dist_to[v]); st.depth(dist_to[v]+1);
         for(auto w : g.adj(v)){
+            st.scan();
             if(!marked[w]){
                 edge_to[w] = v;
                 dist_to[w] = dist_to[v]+1;
@@ -74,10 +146,12 @@ private:
 };
 
 //DFSEqRec - this dfs non-recursive/iterative implementation computes the same paths as DFSRec
-struct dfs_eq_rec_paths_t : public paths_t{
-    dfs_eq_rec_paths_t(graph_t const& g, uint64_t v) : paths_t(g,v){
+template<typename G>
+struct basic_dfs_eq_rec_paths_t : public basic_paths_t<G>{
+    basic_dfs_eq_rec_paths_t(G const& g, uint64_t v) : basic_paths_t<G>(g,v){
+        auto timer = st.phase("traversal");
         for(uint64_t v = 0; v<g.vertices(); ++v){
-            auto& adj = g.adj(v);
+            auto&& adj = g.adj(v);
             its.push_back(adj.begin());
             its_end.push_back(adj.end());
         }
@@ -85,6 +159,12 @@ struct dfs_eq_rec_paths_t : public paths_t{
     }
 
 private:
+    using basic_paths_t<G>::g;
+    using basic_paths_t<G>::marked;
+    using basic_paths_t<G>::edge_to;
+    using basic_paths_t<G>::dist_to;
+    using basic_paths_t<G>::st;
+
     void algo(uint64_t v){
         mark_and_push(infinity, v);
         while(not_empty()){
@@ -104,20 +184,22 @@ private:
         edge_to[w] = v;
         dist_to[w] = v != infinity ? dist_to[v]+1 : 0;
         stack.push(w);
+        st.visit(); st.level(dist_to[w]); st.depth(stack.size());
     }
     bool not_empty(){return stack.size() > 0;}
     uint64_t peek(){return stack.top();}
     void pop(){stack.pop();}
 
     bool has_next(uint64_t v){return its[v] != its_end[v];}
-    uint64_t next(uint64_t v){auto w = *its[v]; its[v]++; return w;}
+    uint64_t next(uint64_t v){auto w = *its[v]; its[v]++; st.scan(); return w;}
 
     //the stack is replacing the recursive calls
     std::stack<uint64_t> stack;
 
     //this is necessary in order to make DFS to behave exactly like the DFSRec
-    std::vector<std::set<uint64_t>::iterator> its;
-    std::vector<std::set<uint64_t>::iterator> its_end;
+    using adj_iterator_t = decltype(std::declval<G const&>().adj(0).begin());
+    std::vector<adj_iterator_t> its;
+    std::vector<adj_iterator_t> its_end;
 };
 
 namespace util{
@@ -127,16 +209,26 @@ namespace util{
 
 //generic paths finder (DFS/BFS)
 //the only difference is the type of the underlying ADT used by the algo
-template<typename ADT>
-struct generic_paths_t : public paths_t{
-    generic_paths_t(graph_t const& g, uint64_t v) : paths_t(g,v){algo(v);}
+template<typename G, typename ADT>
+struct basic_generic_paths_t : public basic_paths_t<G>{
+    basic_generic_paths_t(G const& g, uint64_t v) : basic_paths_t<G>(g,v){
+        auto timer = st.phase("traversal");
+        algo(v);
+    }
 
 private:
+    using basic_paths_t<G>::g;
+    using basic_paths_t<G>::marked;
+    using basic_paths_t<G>::edge_to;
+    using basic_paths_t<G>::dist_to;
+    using basic_paths_t<G>::st;
+
     void algo(uint64_t v){
         mark_and_push(infinity, v);
         while(not_empty()){
             v = peek(); pop();
             for(auto w : g.adj(v)){
+                st.scan();
                 if(!marked[w])
                     mark_and_push(v, w);
             }
@@ -148,6 +240,7 @@ private:
         edge_to[w] = v;
         dist_to[w] = v != infinity ? dist_to[v]+1 : 0;
         adt.push(w);
+        st.visit(); st.level(dist_to[w]); st.depth(adt.size());
     }
     bool not_empty(){return adt.size() > 0;}
     uint64_t peek(){return util::peek(adt);}
@@ -158,7 +251,15 @@ private:
     ADT adt;
 };
 
-using dfs_paths_t = generic_paths_t<std::stack<uint64_t>>;
-using bfs_paths_t = generic_paths_t<std::queue<uint64_t>>;
+template<typename G> using basic_dfs_paths_t = basic_generic_paths_t<G, std::stack<uint64_t>>;
+template<typename G> using basic_bfs_paths_t = basic_generic_paths_t<G, std::queue<uint64_t>>;
+
+//the classic names, on the set based graph_t
+using paths_t = basic_paths_t<graph_t>;
+using dfs_rec_paths_t = basic_dfs_rec_paths_t<graph_t>;
+using dfs_eq_rec_paths_t = basic_dfs_eq_rec_paths_t<graph_t>;
+template<typename ADT> using generic_paths_t = basic_generic_paths_t<graph_t, ADT>;
+using dfs_paths_t = basic_dfs_paths_t<graph_t>;
+using bfs_paths_t = basic_bfs_paths_t<graph_t>;
 
 #endif//__PATHS_H__
@@ -0,0 +1,63 @@
+// to compile (e.g.): g++ -std=c++14 power_law_graph_client.cpp -O3
+// to run (e.g.): ./a.out 100000 16 2.1 [seed] > powerlaw.txt
+//      where 100000: vertices, 16: average degree, 2.1: exponent of the degree distribution
+
+// Chung-Lu model: vertex i gets the weight (i+1)^(-1/(exponent-1)), the edges are drawn with their
+// two ends chosen proportionally to the weights (self-loops and parallel edges are dropped, so the
+// average degree ends up a bit lower). The output uses the format of the datasets.
+
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+
+int main(int argc, char** argv){
+    if(argc != 4 && argc != 5){
+        std::cerr << "Invalid number of arguments" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    uint64_t n = std::stoull(argv[1]);
+    double avg = std::stod(argv[2]);
+    double exponent = std::stod(argv[3]);
+    uint64_t seed = argc == 5 ? std::stoull(argv[4]) : 1;
+    if(n < 2 || exponent <= 1){
+        std::cerr << "Invalid arguments" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::vector<double> weights(n);
+    for(uint64_t i=0; i<n; ++i)
+        weights[i] = std::pow(double(i+1), -1.0 / (exponent - 1));
+
+    std::mt19937_64 gen{seed};
+    std::discrete_distribution<uint64_t> pick{weights.begin(), weights.end()};
+
+    uint64_t m = uint64_t(avg * n / 2);
+    std::vector<std::pair<uint64_t, uint64_t>> edges;
+    edges.reserve(m);
+    for(uint64_t i=0; i<m; ++i){
+        auto v = pick(gen), w = pick(gen);
+        if(v == w) continue;
+        edges.push_back(std::make_pair(std::min(v, w), std::max(v, w)));
+    }
+    std::sort(edges.begin(), edges.end());
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+    //the hubs should not be the smallest ids
+    std::vector<uint64_t> id(n);
+    for(uint64_t i=0; i<n; ++i) id[i] = i;
+    std::shuffle(id.begin(), id.end(), gen);
+
+    std::cout << n << '\n' << edges.size() << '\n';
+    for(auto& e : edges)
+        std::cout << id[e.first] << " " << id[e.second] << '\n';
+
+    return EXIT_SUCCESS;
+}
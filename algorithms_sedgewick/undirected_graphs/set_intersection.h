@@ -0,0 +1,164 @@
+#ifndef __SET_INTERSECTION_H__
+#define __SET_INTERSECTION_H__
+
+#include <algorithm>
+#include <string>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define SET_INTERSECTION_X86
+#include <immintrin.h>
+#endif
+
+//Intersection of sorted arrays of 32 bit ids (without duplicates)...
+
+/*
+
+every kernel writes the common elements to out (room for min(na, nb) of them) and returns how many
+
+merge           one pass over both arrays, O(na + nb), best when the sizes are close
+gallop          for every element of the small array, exponential + binary search in the large one,
+                O(na log(nb/na)), best when one array is much smaller (a leaf against a hub)
+merge_avx2      8x8 blocks: every element of a block of a is compared with the 8 rotations of a block
+                of b, then the block with the smaller last element is skipped
+gallop_avx2     the exponential search jumps over blocks of 8 (looking only at their last element),
+                the element is then compared with the whole block at once
+
+adaptive: gallop when nb > ratio * na, merge otherwise
+(the avx2 kernels only exist on x86, elsewhere simd is the same as gallop)
+
+*/
+
+enum class intersection_t {merge, gallop, simd};
+
+namespace set_intersection{
+    const uint64_t gallop_ratio = 32;
+
+    uint64_t merge(uint32_t const* a, uint64_t na, uint32_t const* b, uint64_t nb, uint32_t* out){
+        uint64_t i{0}, j{0}, n{0};
+        while(i < na && j < nb){
+            if(a[i] < b[j]) ++i;
+            else if(b[j] < a[i]) ++j;
+            else{out[n++] = a[i]; ++i; ++j;}
+        }
+        return n;
+    }
+
+    //small = a, large = b
+    uint64_t gallop(uint32_t const* a, uint64_t na, uint32_t const* b, uint64_t nb, uint32_t* out){
+        uint64_t j{0}, n{0};
+        for(uint64_t i=0; i<na && j<nb; ++i){
+            auto x = a[i];
+            //b[j + step/2] < x <= b[j + step] (or the end)
+            uint64_t step{1};
+            while(j + step < nb && b[j + step] < x) step *= 2;
+            j = std::lower_bound(b + j + step/2, b + std::min(nb, j + step + 1), x) - b;
+            if(j < nb && b[j] == x) out[n++] = x;
+        }
+        return n;
+    }
+
+#ifdef SET_INTERSECTION_X86
+    __attribute__((target("avx2")))
+    uint64_t merge_avx2(uint32_t const* a, uint64_t na, uint32_t const* b, uint64_t nb, uint32_t* out){
+        uint64_t i{0}, j{0}, n{0};
+        auto rot = _mm256_set_epi32(0, 7, 6, 5, 4, 3, 2, 1);
+        while(i + 8 <= na && j + 8 <= nb){
+            auto va = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(a + i));
+            auto vb = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(b + j));
+            auto eq = _mm256_cmpeq_epi32(va, vb);
+            for(int r=1; r<8; ++r){
+                vb = _mm256_permutevar8x32_epi32(vb, rot);
+                eq = _mm256_or_si256(eq, _mm256_cmpeq_epi32(va, vb));
+            }
+            //the elements of the block of a that are somewhere in the block of b, in order
+            for(auto m = unsigned(_mm256_movemask_ps(_mm256_castsi256_ps(eq))); m; m &= m - 1)
+                out[n++] = a[i + __builtin_ctz(m)];
+
+            auto amax = a[i + 7], bmax = b[j + 7];
+            if(amax <= bmax) i += 8;
+            if(bmax <= amax) j += 8;
+        }
+        return n + merge(a + i, na - i, b + j, nb - j, out + n);
+    }
+
+    //small = a, large = b
+    __attribute__((target("avx2")))
+    uint64_t gallop_avx2(uint32_t const* a, uint64_t na, uint32_t const* b, uint64_t nb, uint32_t* out){
+        uint64_t j{0}, n{0}, i{0};
+        for(; i<na && j + 8 <= nb; ++i){
+            auto x = a[i];
+            if(b[j + 7] < x){
+                //gallop over the blocks of 8 after j, then narrow down to lo < hi <= lo + 8 with
+                //b[lo+7] < x <= b[hi+7]: the block at hi holds everything that can still be x
+                uint64_t lo{j}, step{8};
+                while(lo + step + 8 <= nb && b[lo + step + 7] < x){
+                    lo += step;
+                    step *= 2;
+                }
+                uint64_t hi = std::min(lo + step, nb - 8);
+                if(b[hi + 7] < x){
+                    //x is past the last full block
+                    j = hi + 1;
+                    break;
+                }
+                while(hi - lo > 8){
+                    auto mid = lo + std::max<uint64_t>(8, (hi - lo) / 16 * 8);
+                    if(b[mid + 7] < x) lo = mid;
+                    else hi = mid;
+                }
+                j = hi;
+            }
+            auto vb = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(b + j));
+            if(_mm256_movemask_epi8(_mm256_cmpeq_epi32(vb, _mm256_set1_epi32(int(x)))))
+                out[n++] = x;
+        }
+        return n + merge(a + i, na - i, b + j, nb - j, out + n);
+    }
+
+    bool simd_supported(){
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2");
+    }
+#else
+    bool simd_supported(){return false;}
+#endif
+
+    //the kernels of a kind (the simd one falls back to the scalar kernels without avx2)
+    struct kernels_t{
+        using fn_t = uint64_t (*)(uint32_t const*, uint64_t, uint32_t const*, uint64_t, uint32_t*);
+
+        explicit kernels_t(intersection_t kind){
+            if(kind == intersection_t::simd && !simd_supported())
+                kind = intersection_t::gallop;
+            switch(kind){
+                case intersection_t::merge: merge_fn = merge; gallop_fn = nullptr; label = "merge"; break;
+                case intersection_t::gallop: merge_fn = merge; gallop_fn = gallop; label = "merge + gallop"; break;
+#ifdef SET_INTERSECTION_X86
+                case intersection_t::simd: merge_fn = merge_avx2; gallop_fn = gallop_avx2; label = "avx2 merge + gallop"; break;
+#else
+                case intersection_t::simd: break;
+#endif
+            }
+        }
+
+        uint64_t operator()(uint32_t const* a, uint64_t na, uint32_t const* b, uint64_t nb, uint32_t* out)const{
+            if(na > nb){
+                std::swap(a, b);
+                std::swap(na, nb);
+            }
+            if(gallop_fn && nb > gallop_ratio * na)
+                return gallop_fn(a, na, b, nb, out);
+            return merge_fn(a, na, b, nb, out);
+        }
+
+        std::string const& name()const{return label;}
+
+    private:
+        fn_t merge_fn;
+        fn_t gallop_fn;
+        std::string label;
+    };
+}
+
+#endif//__SET_INTERSECTION_H__
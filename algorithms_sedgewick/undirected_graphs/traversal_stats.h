@@ -0,0 +1,129 @@
+#ifndef __TRAVERSAL_STATS_H__
+#define __TRAVERSAL_STATS_H__
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+#include <cstdint>
+
+//Opt-in counters for the graph algorithms...
+
+/*
+
+compile with -DSTATS to get them, otherwise every call below is an empty inline function
+and the algorithms are exactly the same as without instrumentation.
+
+vertices visited        vertices marked by the traversal
+edges scanned           adjacency entries looked at (each undirected edge is seen from both ends)
+max depth               maximum stack/queue size (or recursion depth)
+level sizes             number of vertices discovered at each distance from the source
+                        (the bfs frontiers; for dfs it is the depth in the dfs tree)
+phases                  wall time per phase (load, traversal, path reconstruction, ...)
+
+*/
+
+#ifdef STATS
+
+struct traversal_stats_t{
+    //measures the time spent in a phase until it goes out of scope
+    struct phase_timer_t{
+        phase_timer_t(traversal_stats_t& st, char const* name) : st{st}, name{name}, start{std::chrono::steady_clock::now()}{}
+        phase_timer_t(phase_timer_t&& o) : st{o.st}, name{o.name}, start{o.start}{o.active = false;}
+        ~phase_timer_t(){
+            if(active)
+                st.add_time(name, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+        }
+
+        traversal_stats_t& st;
+        char const* name;
+        std::chrono::steady_clock::time_point start;
+        bool active{true};
+    };
+
+    //one call of a recursive dfs until it goes out of scope (the depth is counted here, not passed along)
+    struct frame_t{
+        frame_t(traversal_stats_t& st) : st{st}{
+            ++st.current_depth;
+            st.visit(); st.level(st.current_depth-1); st.depth(st.current_depth);
+        }
+        frame_t(frame_t&& o) : st{o.st}{o.active = false;}
+        ~frame_t(){if(active) --st.current_depth;}
+
+        traversal_stats_t& st;
+        bool active{true};
+    };
+
+    void visit(){++vertices_visited;}
+    void scan(){++edges_scanned;}
+    void depth(uint64_t d){if(d > max_depth) max_depth = d;}
+    frame_t enter(){return frame_t{*this};}
+    void level(uint64_t l){
+        if(l >= level_sizes.size()) level_sizes.resize(l+1, 0);
+        ++level_sizes[l];
+    }
+    phase_timer_t phase(char const* name){return phase_timer_t{*this, name};}
+
+    void add_time(std::string const& name, double seconds){
+        for(auto& p : phases)
+            if(p.first == name){p.second += seconds; return;}
+        phases.emplace_back(name, seconds);
+    }
+
+    //accumulates the stats of another run (e.g. one paths_t per source)
+    traversal_stats_t& operator+=(traversal_stats_t const& o){
+        vertices_visited += o.vertices_visited;
+        edges_scanned += o.edges_scanned;
+        depth(o.max_depth);
+        if(o.level_sizes.size() > level_sizes.size()) level_sizes.resize(o.level_sizes.size(), 0);
+        for(uint64_t l=0; l<o.level_sizes.size(); ++l) level_sizes[l] += o.level_sizes[l];
+        for(auto& p : o.phases) add_time(p.first, p.second);
+        return *this;
+    }
+
+    uint64_t vertices_visited{0};
+    uint64_t edges_scanned{0};
+    uint64_t max_depth{0};
+    std::vector<uint64_t> level_sizes;
+    std::vector<std::pair<std::string, double>> phases;
+    //depth of the recursive dfs in progress
+    uint64_t current_depth{0};
+};
+
+//{"vertices_visited": ..., "edges_scanned": ..., "max_depth": ..., "level_sizes": [...], "phases": {...}}
+std::ostream& operator<<(std::ostream& os, traversal_stats_t const& st){
+    os  << "{\"vertices_visited\": " << st.vertices_visited
+        << ", \"edges_scanned\": " << st.edges_scanned
+        << ", \"max_depth\": " << st.max_depth
+        << ", \"level_sizes\": [";
+    for(uint64_t l=0; l<st.level_sizes.size(); ++l)
+        os << (l ? ", " : "") << st.level_sizes[l];
+    os << "], \"phases\": {";
+    for(uint64_t i=0; i<st.phases.size(); ++i)
+        os << (i ? ", " : "") << "\"" << st.phases[i].first << "\": " << st.phases[i].second;
+    return os << "}}";
+}
+
+#else
+
+struct traversal_stats_t{
+    //not trivially destructible, so that the unused timers do not trigger warnings
+    struct phase_timer_t{~phase_timer_t(){}};
+    struct frame_t{~frame_t(){}};
+
+    void visit(){}
+    void scan(){}
+    void depth(uint64_t){}
+    frame_t enter(){return frame_t{};}
+    void level(uint64_t){}
+    phase_timer_t phase(char const*){return phase_timer_t{};}
+
+    traversal_stats_t& operator+=(traversal_stats_t const&){return *this;}
+};
+
+std::ostream& operator<<(std::ostream& os, traversal_stats_t const&){return os << "{}";}
+
+#endif
+
+#endif//__TRAVERSAL_STATS_H__
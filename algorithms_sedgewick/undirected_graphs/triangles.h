@@ -0,0 +1,86 @@
+#ifndef __TRIANGLES_H__
+#define __TRIANGLES_H__
+
+#include "graph.h"
+#include "csr_graph.h"
+#include "parallel.h"
+#include "set_intersection.h"
+
+#include <atomic>
+#include <memory>
+
+//Count the triangles (3 vertices, pairwise adjacent) of a graph...
+
+/*
+
+On the degree oriented graph (every edge goes from the smaller (degree, id) end to the other one) every
+triangle u, v, w has exactly one vertex with both edges going out of it, so:
+
+    for every u, for every v in out(u): the triangles u-v-w are the w in out(u) & out(v)
+
+Every out list is sorted and has at most sqrt(2E) vertices, the total work is O(E^1.5) in the worst case
+and much less on real graphs. The vertices are split between the threads dynamically (chunks taken from a
+shared counter), so a thread that gets the few expensive vertices of a power-law graph does not hold the
+others back.
+
+The per vertex counts (how many triangles go through v) are optional, they need an atomic add per corner.
+
+*/
+
+struct triangles_t{
+    triangles_t(graph_t const& g, intersection_t kind = intersection_t::simd, bool per_vertex = false, uint64_t nthreads = 0)
+        : dag{csr_graph_t::degree_oriented(g)}, kernels{kind}, nthreads{parallel::threads(nthreads)}
+    {
+        if(per_vertex){
+            per_v = std::make_unique<std::atomic<uint64_t>[]>(g.vertices());
+            for(uint64_t v=0; v<g.vertices(); ++v)
+                per_v[v].store(0, std::memory_order_relaxed);
+        }
+
+        std::vector<uint64_t> partial(this->nthreads, 0);
+        std::vector<std::vector<uint32_t>> buffers(this->nthreads, std::vector<uint32_t>(dag.max_degree()));
+        parallel::for_dynamic(dag.vertices(), this->nthreads, 64, [&](uint64_t lo, uint64_t hi, uint64_t t){
+            auto common = buffers[t].data();
+            uint64_t n{0};
+            for(uint64_t u=lo; u<hi; ++u){
+                auto out_u = dag.adj(u);
+                for(auto v : out_u){
+                    auto out_v = dag.adj(v);
+                    auto k = kernels(out_u.begin(), out_u.size(), out_v.begin(), out_v.size(), common);
+                    n += k;
+                    if(per_v && k){
+                        per_v[u].fetch_add(k, std::memory_order_relaxed);
+                        per_v[v].fetch_add(k, std::memory_order_relaxed);
+                        for(uint64_t i=0; i<k; ++i)
+                            per_v[common[i]].fetch_add(1, std::memory_order_relaxed);
+                    }
+                }
+            }
+            partial[t] += n;
+        });
+        for(auto n : partial)
+            total += n;
+    }
+
+    //total number of triangles
+    uint64_t count()const{return total;}
+
+    //number of triangles that go through v (only when built with per_vertex)
+    uint64_t count(uint64_t v)const{
+        assert(per_v);
+        assert(v < dag.vertices());
+        return per_v[v].load(std::memory_order_relaxed);
+    }
+
+    std::string const& name()const{return kernels.name();}
+
+private:
+    csr_graph_t dag;
+    set_intersection::kernels_t kernels;
+    uint64_t nthreads;
+
+    uint64_t total{0};
+    std::unique_ptr<std::atomic<uint64_t>[]> per_v;
+};
+
+#endif//__TRIANGLES_H__
@@ -0,0 +1,98 @@
+#ifndef __WRITER_H__
+#define __WRITER_H__
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+
+//Buffered output for the clients...
+
+/*
+
+std::cout << x << std::endl flushes on every line and goes through the locale/formatting
+machinery for every number. The writer keeps a large buffer, formats the integers itself and
+hands the bytes to the underlying stream only when the buffer is full (or at the end).
+
+    writer_t out{std::cout};
+    out << "From " << v << " to" << '\n';
+
+the output is byte for byte the same as with std::cout ('\n' instead of std::endl).
+
+*/
+
+struct writer_t{
+    //(at least 64 bytes: a number is formatted in place, it must fit in an empty buffer)
+    explicit writer_t(std::ostream& os, uint64_t capacity = 1 << 16) : os{os}, buf(std::max<uint64_t>(capacity, 64)){}
+    ~writer_t(){flush();}
+
+    writer_t(writer_t const&) = delete;
+    writer_t& operator=(writer_t const&) = delete;
+
+    writer_t& operator<<(uint64_t x){
+        reserve(20);
+        //digits are produced backwards, then copied in place
+        char tmp[20];
+        char* p = tmp + sizeof(tmp);
+        do{
+            *--p = char('0' + x % 10);
+            x /= 10;
+        }while(x);
+        auto n = tmp + sizeof(tmp) - p;
+        std::memcpy(&buf[pos], p, n);
+        pos += n;
+        return *this;
+    }
+    writer_t& operator<<(int64_t x){
+        if(x < 0){
+            *this << '-';
+            return *this << (~uint64_t(x) + 1);
+        }
+        return *this << uint64_t(x);
+    }
+    writer_t& operator<<(int x){return *this << int64_t(x);}
+
+    writer_t& operator<<(char c){
+        reserve(1);
+        buf[pos++] = c;
+        return *this;
+    }
+    writer_t& operator<<(char const* s){return write(s, std::strlen(s));}
+    writer_t& operator<<(std::string const& s){return write(s.data(), s.size());}
+
+    writer_t& write(char const* s, uint64_t n){
+        if(n > buf.size()){
+            flush();
+            os.write(s, n);
+            return *this;
+        }
+        reserve(n);
+        std::memcpy(&buf[pos], s, n);
+        pos += n;
+        return *this;
+    }
+
+    void flush(){
+        if(pos){
+            os.write(buf.data(), pos);
+            pos = 0;
+        }
+        os.flush();
+    }
+
+private:
+    void reserve(uint64_t n){
+        if(pos + n > buf.size()){
+            os.write(buf.data(), pos);
+            pos = 0;
+        }
+    }
+
+    std::ostream& os;
+    std::vector<char> buf;
+    uint64_t pos{0};
+};
+
+#endif//__WRITER_H__
@@ -0,0 +1,164 @@
+/*
+to compile (e.g.): g++ -std=c++14 hk_percolation.cpp -O3
+to run (e.g.): ./a.out site 2 1000 0.5927 [samples] [seed]
+    lattice: site | bond, dimensions: 2 | 3, grid size N, probability p
+to cross-check (small grids, 2D and 3D, site and bond): ./a.out check
+    every lattice is compared with a union-find on the full lattice (and with percolation.cpp for 2D site),
+    a mismatch prints its seed: ./a.out check site 3 5 <seed> reruns that lattice alone
+
+    thresholds (for reference): 2D site 0.5927, 2D bond 0.5, 3D site 0.3116, 3D bond 0.2488
+*/
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <numeric>
+#include <string>
+
+#include "hoshen_kopelman.h"
+#include "percolation.h"
+
+// a random lattice from the seed (a random number k of sites / bonds opened in a seeded random order):
+// the layer by layer labeling must find the same clusters as a union-find on the full lattice,
+// and the same spanning as percolation_simulation for the 2D site lattice
+bool check(uint64_t N, uint64_t dims, lattice_t kind, uint64_t seed) {
+    uint64_t L = dims == 2 ? N : N*N, cells = N*L;
+    //site: one item per cell, bond: 3 per cell (to the layer above, to x-1, to y-1), the ones off the lattice are ignored
+    uint64_t items = kind == lattice_t::site ? cells : 3*cells;
+    std::vector<uint64_t> order(items);
+    std::iota(order.begin(), order.end(), 0);
+    std::mt19937_64 gen{seed};
+    std::shuffle(order.begin(), order.end(), gen);
+    uint64_t k = std::uniform_int_distribution<uint64_t>{0, items}(gen);
+    std::vector<char> opened(items, 0);
+    for (uint64_t pos = 0; pos < k; ++pos)
+        opened[order[pos]] = 1;
+
+    auto occupied = [&](uint64_t cell) { return kind == lattice_t::bond || opened[cell]; };
+    auto open = [&](uint64_t cell, uint64_t axis) { return kind == lattice_t::site || opened[cell*3 + axis]; };
+
+    hoshen_kopelman hk{N, dims, kind};
+    auto st = hk.run([&](uint64_t layer, uint64_t i) { return occupied(layer*L + i); },
+                     [&](uint64_t layer, uint64_t i, uint64_t axis) { return open(layer*L + i, axis); });
+
+    //brute force: the whole lattice in one union-find
+    union_find_weighted_quick_union_path_compression uf{cells};
+    for (uint64_t cell = 0; cell < cells; ++cell) {
+        if (!occupied(cell)) continue;
+        uint64_t layer{cell / L}, x{cell % L % N}, y{cell % L / N};
+        if (layer > 0 && occupied(cell-L) && open(cell, 0)) uf.connect(cell, cell-L);
+        if (x > 0 && occupied(cell-1) && open(cell, 1)) uf.connect(cell, cell-1);
+        if (dims == 3 && y > 0 && occupied(cell-N) && open(cell, 2)) uf.connect(cell, cell-N);
+    }
+    cluster_stats_t expected;
+    std::vector<char> top(cells, 0);
+    for (uint64_t cell = 0; cell < cells; ++cell) {
+        if (!occupied(cell)) continue;
+        ++expected.occupied;
+        if (uf.find(cell) == cell) expected.add(uf.size(cell));
+        if (cell < L) top[uf.find(cell)] = 1;
+        if (cell >= cells - L) expected.spans = expected.spans || top[uf.find(cell)];
+    }
+
+    bool same = st.spans == expected.spans && st.occupied == expected.occupied && st.clusters == expected.clusters
+             && st.largest == expected.largest && st.sizes == expected.sizes;
+
+    if (dims == 2 && kind == lattice_t::site) {
+        percolation_simulation ps{N};
+        for (uint64_t pos = 0; pos < k; ++pos)
+            ps.open(order[pos]);
+        same = same && st.spans == ps.percolates();
+    }
+    return same;
+}
+
+int main(int argc, char** argv){
+    if (argc >= 2 && std::string(argv[1]) == "check") {
+        if (argc != 2 && argc != 6) {
+            std::cerr << "invalid number of arguments" << std::endl;
+            return EXIT_FAILURE;
+        }
+        //one lattice (e.g. a failure reported below): ./a.out check lattice dimensions N seed
+        if (argc == 6) {
+            std::string lattice = argv[2];
+            uint64_t dims = std::stoull(argv[3]), N = std::stoull(argv[4]);
+            if ((lattice != "site" && lattice != "bond") || (dims != 2 && dims != 3) || N == 0) {
+                std::cerr << "Invalid arguments" << std::endl;
+                return EXIT_FAILURE;
+            }
+            bool ok = check(N, dims, lattice == "site" ? lattice_t::site : lattice_t::bond, std::stoull(argv[5]));
+            std::cout << (ok ? "same" : "DIFFERENT") << std::endl;
+            return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+
+        uint64_t trials = 0, failures = 0;
+        std::mt19937_64 gen{42};
+        for (auto kind : {lattice_t::site, lattice_t::bond}) {
+            for (uint64_t dims : {2, 3}) {
+                for (uint64_t N : {1, 2, 3, 5, 10, 20}) {
+                    for (uint64_t t = 0; t < 100; ++t) {
+                        uint64_t seed = gen();
+                        ++trials;
+                        if (!check(N, dims, kind, seed)) {
+                            ++failures;
+                            std::cout << "mismatch: " << hoshen_kopelman{N, dims, kind}.name() << ", N: " << N
+                                      << ", seed: " << seed << std::endl;
+                        }
+                    }
+                }
+            }
+        }
+        std::cout << "trials: " << trials << ", mismatches: " << failures << std::endl;
+        return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+    }
+
+    if (argc < 5 || argc > 7) {
+        std::cerr << "invalid number of arguments" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::string lattice = argv[1];
+    uint64_t dims = std::stoull(argv[2]);
+    uint64_t N = std::stoull(argv[3]);
+    if ((lattice != "site" && lattice != "bond") || (dims != 2 && dims != 3) || N == 0) {
+        std::cerr << "Invalid arguments" << std::endl;
+        return EXIT_FAILURE;
+    }
+    auto kind = lattice == "site" ? lattice_t::site : lattice_t::bond;
+    double p = std::stod(argv[4]);
+    uint64_t M = argc > 5 ? std::stoull(argv[5]) : 1;
+    uint64_t seed = argc > 6 ? std::stoull(argv[6]) : std::random_device{}();
+
+    hoshen_kopelman hk{N, dims, kind};
+    std::cout << hk.name() << ", grid size: " << N << (dims == 2 ? "^2" : "^3") << ", p: " << p << std::endl;
+
+    uint64_t spanning = 0;
+    double clusters = 0, largest = 0, mean_size = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < M; ++i) {
+        auto st = hk.run(p, seed + i);
+        spanning += st.spans;
+        clusters += st.clusters;
+        largest += st.largest;
+        //average size of the cluster a site belongs to, without the largest one
+        double s1 = 0, s2 = 0;
+        for (auto& kv : st.sizes) {
+            auto n = kv.first == st.largest ? kv.second - 1 : kv.second;
+            s1 += double(n) * kv.first;
+            s2 += double(n) * kv.first * kv.first;
+        }
+        mean_size += s1 ? s2 / s1 : 0;
+    }
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    double sites = dims == 2 ? double(N)*N : double(N)*N*N;
+    std::cout << std::fixed << std::setprecision(4)
+              << "number of simulations: " << M << std::endl
+              << "spanning probability: " << double(spanning) / M << std::endl
+              << "clusters per site: " << clusters / M / sites << std::endl
+              << "largest cluster fraction: " << largest / M / sites << std::endl
+              << "mean cluster size (without the largest): " << mean_size / M << std::endl
+              << "time per simulation: " << elapsed / M << "s" << std::endl;
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <limits>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "uf_impl.h"
+
+// Hoshen-Kopelman: cluster labeling one layer at a time
+
+/*
+The grid is N^d sites (d = 2 or 3) and it is never stored. A layer is a row (2D) or a plane (3D),
+L = N^(d-1) sites. Going from the top layer to the bottom one:
+    - the union-find only has slots for the K clusters still alive in the previous layer + the L sites
+      of the current layer, so it is rebuilt for every layer (memory O(L) instead of O(N^d))
+    - every site is connected to its neighbours in the current layer and to the site above it
+    - the clusters of the previous layer that got no site in the current one are finished
+      (their size goes to the statistics), the others are renumbered 0..K'-1 for the next layer
+
+site percolation: every site is occupied with probability p, neighbouring occupied sites are connected
+bond percolation: every site is occupied, every bond (between 2 neighbours) is open with probability p
+
+A cluster spans if it touches both the top and the bottom layer (same as percolation.cpp).
+*/
+
+enum class lattice_t {site, bond};
+
+struct cluster_stats_t {
+    bool spans{false};
+    uint64_t occupied{0};
+    uint64_t clusters{0};
+    uint64_t largest{0};
+    //cluster size -> number of clusters of that size
+    std::map<uint64_t, uint64_t> sizes;
+
+    void add(uint64_t size) {
+        ++clusters;
+        largest = std::max(largest, size);
+        ++sizes[size];
+    }
+};
+
+struct hoshen_kopelman {
+    static constexpr uint64_t none = std::numeric_limits<uint64_t>::max();
+
+    hoshen_kopelman(uint64_t N, uint64_t dims, lattice_t kind) : N{N}, dims{dims}, kind{kind} {
+        assert(N > 0 && (dims == 2 || dims == 3));
+        L = dims == 2 ? N : N*N;
+    }
+
+    // random lattice with occupation (site) or opening (bond) probability p
+    cluster_stats_t run(double p, uint64_t seed) {
+        std::mt19937_64 gen{seed};
+        std::bernoulli_distribution coin{p};
+        auto draw = [&](uint64_t, uint64_t, uint64_t) { return coin(gen); };
+        if (kind == lattice_t::site)
+            return run([&](uint64_t layer, uint64_t i) { return draw(layer, i, 0); }, [](uint64_t, uint64_t, uint64_t) { return true; });
+        return run([](uint64_t, uint64_t) { return true; }, draw);
+    }
+
+    // occupied(layer, i): is site i of the layer occupied? (site percolation, called once per site, in order)
+    // open(layer, i, axis): is the bond between site i and its previous neighbour along axis open? (bond percolation)
+    //      axis 0 = the layer above, 1 = i-1 (x), 2 = i-N (y, 3D only)
+    template<typename Occupied, typename Open>
+    cluster_stats_t run(Occupied&& occupied, Open&& open) {
+        cluster_stats_t st;
+
+        //what is left from the previous layer: the label of every site and the live clusters
+        std::vector<uint64_t> prev(L, none), cur(L, none);
+        std::vector<uint64_t> size, next_size;
+        std::vector<bool> top, next_top;
+
+        for (uint64_t layer = 0; layer < N; ++layer) {
+            uint64_t K = size.size();
+            union_find_weighted_quick_union_path_compression uf{K + L};
+
+            for (uint64_t i = 0; i < L; ++i) {
+                cur[i] = none;
+                if (kind == lattice_t::site && !occupied(layer, i))
+                    continue;
+                cur[i] = K + i;
+                ++st.occupied;
+
+                uint64_t x{i % N}, y{i / N};
+                if (x > 0 && cur[i-1] != none && (kind == lattice_t::site || open(layer, i, 1)))
+                    uf.connect(K + i, K + i - 1);
+                if (dims == 3 && y > 0 && cur[i-N] != none && (kind == lattice_t::site || open(layer, i, 2)))
+                    uf.connect(K + i, K + i - N);
+                if (prev[i] != none && (kind == lattice_t::site || open(layer, i, 0)))
+                    uf.connect(K + i, prev[i]);
+            }
+
+            //new compact labels for the clusters that reach the current layer
+            std::vector<uint64_t> root_to_label(K + L, none);
+            next_size.clear();
+            next_top.clear();
+            for (uint64_t i = 0; i < L; ++i) {
+                if (cur[i] == none) continue;
+                auto r = uf.find(K + i);
+                if (root_to_label[r] == none) {
+                    root_to_label[r] = next_size.size();
+                    next_size.push_back(0);
+                    next_top.push_back(layer == 0);
+                }
+                cur[i] = root_to_label[r];
+                ++next_size[cur[i]];
+            }
+            for (uint64_t c = 0; c < K; ++c) {
+                auto l = root_to_label[uf.find(c)];
+                if (l == none) {
+                    //no site in this layer => the cluster is complete
+                    st.add(size[c]);
+                } else {
+                    next_size[l] += size[c];
+                    next_top[l] = next_top[l] || top[c];
+                }
+            }
+
+            std::swap(prev, cur);
+            std::swap(size, next_size);
+            std::swap(top, next_top);
+        }
+
+        //the clusters touching the bottom layer
+        for (uint64_t c = 0; c < size.size(); ++c) {
+            st.add(size[c]);
+            st.spans = st.spans || top[c];
+        }
+        return st;
+    }
+
+    std::string name() const {
+        return std::to_string(dims) + "D " + (kind == lattice_t::site ? "site" : "bond") + " percolation";
+    }
+
+    uint64_t N, dims;
+    lattice_t kind;
+    //sites per layer
+    uint64_t L;
+};
+
+constexpr uint64_t hoshen_kopelman::none;
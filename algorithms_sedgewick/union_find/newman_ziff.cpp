@@ -0,0 +1,79 @@
+/*
+to compile (e.g.): g++ -std=c++14 newman_ziff.cpp -O3
+to run (e.g.): ./a.out 100 1000 201 > curve.csv
+    grid size N, number of samples, number of points in the p grid [0, 1]
+    output (csv): p,spanning_probability,largest_cluster_fraction
+to compare with one experiment per value of p: ./a.out 100 1000 201 naive > curve.csv
+    (the timings go to stderr)
+*/
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <string>
+
+#include "percolation.h"
+
+int main(int argc, char** argv){
+    if (argc != 4 && argc != 5) {
+        std::cerr << "invalid number of arguments" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    uint64_t N = std::stoull(argv[1]);
+    uint64_t M = std::stoull(argv[2]);
+    uint64_t P = std::max<uint64_t>(2, std::stoull(argv[3]));
+    bool naive = argc == 5 && std::string(argv[4]) == "naive";
+    if (N == 0 || M == 0) {
+        std::cerr << "Invalid arguments" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::vector<double> ps;
+    for (uint64_t i = 0; i < P; ++i)
+        ps.push_back(double(i) / (P - 1));
+
+    std::vector<double> spanning(ps.size(), 0), largest(ps.size(), 0);
+    auto start = std::chrono::steady_clock::now();
+
+    if (naive) {
+        //for every p: M simulations opening round(p*N*N) cells
+        for (uint64_t i = 0; i < ps.size(); ++i) {
+            uint64_t n = uint64_t(std::round(ps[i] * N * N));
+            for (uint64_t j = 0; j < M; ++j) {
+                newman_ziff_simulation nz{N};
+                while (nz.opened < n)
+                    nz.open_next();
+                spanning[i] += nz.percolates();
+                largest[i] += double(nz.largest) / (N*N);
+            }
+            spanning[i] /= M;
+            largest[i] /= M;
+        }
+    } else {
+        //M sweeps, then the binomial average for every p
+        std::vector<double> Qs, Ql;
+        for (uint64_t j = 0; j < M; ++j) {
+            newman_ziff_simulation nz{N};
+            nz.sweep(Qs, Ql);
+        }
+        for (uint64_t n = 0; n < Qs.size(); ++n) {
+            Qs[n] /= M;
+            Ql[n] /= M;
+        }
+        for (uint64_t i = 0; i < ps.size(); ++i) {
+            spanning[i] = binomial_convolution(Qs, ps[i]);
+            largest[i] = binomial_convolution(Ql, ps[i]);
+        }
+    }
+
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cerr << (naive ? "one experiment per p" : "newman-ziff") << ": " << elapsed << "s" << std::endl;
+
+    std::cout << "p,spanning_probability,largest_cluster_fraction" << std::endl;
+    std::cout << std::fixed << std::setprecision(6);
+    for (uint64_t i = 0; i < ps.size(); ++i)
+        std::cout << ps[i] << "," << spanning[i] << "," << largest[i] << '\n';
+
+    return EXIT_SUCCESS;
+}
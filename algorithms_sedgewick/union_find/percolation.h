@@ -0,0 +1,164 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+
+#include "uf_impl.h"
+#include "uf_util.h"
+
+// percolation on a NxN grid: the cells are opened in a random order until the top and bottom rows are connected
+
+struct percolation_simulation{
+    percolation_simulation(uint64_t sz)
+        : N{sz}, top{N*N}, bottom{top+1}
+    {
+        //add 2 virtual cells: top, bottom (read he notes)
+        //and use the fastes algorithm (for large number of cells)
+        uf = build_algorithm(N*N+2, "wqupc");
+
+        cells.resize(N*N);
+        std::iota(cells.begin(), cells.end(), 0);
+        //open the cells in a random order
+        std::random_device rd;
+        std::default_random_engine gen{rd()};
+        std::shuffle(cells.begin(), cells.end(), gen);
+        //init all cells as closed
+        state.resize(N*N, 0);
+    }
+
+    uint64_t run(){
+        uint64_t pos = 0;
+        for (; pos < cells.size(); ++pos) {
+            //stop when the top and bottom cells are connected
+            if (uf->connected(top, bottom)) break;
+            open(cells[pos]);
+        }
+        return pos;
+    }
+
+    void open(uint64_t cell) {
+        //set the cell as open
+        state[cell] = 1;
+        //connect it to its neighbours
+        connect_with_neighbors(cell);
+    }
+
+    bool percolates() { return uf->connected(top, bottom); }
+
+    void connect_with_neighbors(uint64_t cell) {
+        //compute 2D coordinates (l = line, c = column)
+        uint64_t l{cell / N}, c{cell % N};
+
+        //do the necessary connections
+        uint64_t neighbours[] = {   (l>0    ? (l-1)*N+c : c),
+                                    (l<N-1  ? (l+1)*N+c : l*N+c),
+                                    (c>0    ? l*N+(c-1) : l*N+c),
+                                    (c<N-1  ? l*N+(c+1) : l*N+c)  };
+        for (auto neighbour : neighbours)
+            if (state[neighbour])
+                uf->connect(cell, neighbour);
+
+        //connect to the virtual cells if possible
+        if (l == 0) uf->connect(cell, top);
+        if (l == N-1) uf->connect(cell, bottom);
+    }
+
+    uint64_t N;
+    //list of closed cells
+    std::vector<uint64_t> cells;
+    std::vector<uint64_t> state;
+    //indexes of the 2 virtual cells
+    uint64_t top, bottom;
+    //union-find algo
+    std::unique_ptr<union_find> uf;
+};
+
+//an experiment is composed from multiple simulations
+struct percolation_experiment {
+    percolation_experiment(uint64_t sz, uint64_t rep)
+        : N{sz}, M{rep}
+    {}
+
+    double run() {
+        uint64_t result = 0;
+        for (uint64_t i=0; i<M; ++i) {
+            percolation_simulation ps{N};
+            result += ps.run();
+        }
+        return (double)result / (N*N*M);
+    }
+
+    uint64_t N, M;
+};
+
+// Newman-Ziff: one sweep per sample, opening all the cells in percolation_simulation's random order
+// and recording the observables after every cell (Q_n, n = number of open cells).
+// Q(p) is then the binomial average of the Q_n (see binomial_convolution), for any p,
+// instead of one simulation per value of p.
+struct newman_ziff_simulation : public percolation_simulation {
+    newman_ziff_simulation(uint64_t sz)
+        : percolation_simulation(sz), clusters{N*N}
+    {}
+
+    //opens the next cell in the random order
+    void open_next() {
+        auto cell = cells[opened++];
+        open(cell);
+
+        //the virtual top/bottom cells merge all the clusters touching the top/bottom rows,
+        //so the cluster sizes are tracked by a second union-find without them
+        uint64_t l{cell / N}, c{cell % N};
+        if (l > 0 && state[cell-N]) clusters.connect(cell, cell-N);
+        if (l < N-1 && state[cell+N]) clusters.connect(cell, cell+N);
+        if (c > 0 && state[cell-1]) clusters.connect(cell, cell-1);
+        if (c < N-1 && state[cell+1]) clusters.connect(cell, cell+1);
+        largest = std::max(largest, clusters.size(cell));
+    }
+
+    //adds the spanning indicator and the largest cluster fraction after n open cells to spanning[n] and largest_fraction[n]
+    void sweep(std::vector<double>& spanning, std::vector<double>& largest_fraction) {
+        spanning.resize(N*N+1, 0);
+        largest_fraction.resize(N*N+1, 0);
+        for (uint64_t n = 1; n <= N*N; ++n) {
+            open_next();
+            spanning[n] += percolates();
+            largest_fraction[n] += double(largest) / (N*N);
+        }
+    }
+
+    uint64_t opened{0};
+    //size of the largest cluster so far
+    uint64_t largest{0};
+    union_find_weighted_quick_union_path_compression clusters;
+};
+
+// Q(p) = sum_n C(M,n) p^n (1-p)^(M-n) Q_n, M = Q.size()-1
+// the binomial weights are computed from the mode outwards and cut when they become negligible
+double binomial_convolution(std::vector<double> const& Q, double p) {
+    assert(!Q.empty());
+    uint64_t M = Q.size() - 1;
+    if (p <= 0) return Q[0];
+    if (p >= 1) return Q[M];
+
+    uint64_t mode = std::min<uint64_t>(M, uint64_t(p * (M + 1)));
+    double log_mode = std::lgamma(M + 1.0) - std::lgamma(mode + 1.0) - std::lgamma(M - mode + 1.0)
+                    + mode * std::log(p) + (M - mode) * std::log1p(-p);
+    double ratio = p / (1 - p), eps = 1e-16;
+
+    double w_mode = std::exp(log_mode);
+    double result = w_mode * Q[mode];
+    //B(n+1) = B(n) * (M-n)/(n+1) * p/(1-p)
+    double w = w_mode;
+    for (uint64_t n = mode; n < M && w > eps * w_mode; ++n) {
+        w *= double(M - n) / (n + 1) * ratio;
+        result += w * Q[n+1];
+    }
+    w = w_mode;
+    for (uint64_t n = mode; n > 0 && w > eps * w_mode; --n) {
+        w *= double(n) / (M - n + 1) / ratio;
+        result += w * Q[n-1];
+    }
+    return result;
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <string>
+
+#include <assert.h>
+
+// lock-free union find, safe to call from many threads at the same time
+
+/*
+the ids are atomics and every change is a compare-and-swap:
+    connect     link the root with the smaller index under the other one, the CAS only succeeds while
+                it is still a root (otherwise another thread got there first: find the roots again)
+    find        path halving, the CAS that shortens the path may fail, it is only an optimization
+
+Every pointer goes from a smaller index to a larger one (linking and halving both keep that), so
+concurrent updates can't make a cycle. There is no rank (a CAS can't update two words), with path
+halving the trees stay shallow in practice.
+
+connect returns true only for the call that actually merged two components, so the callers can
+count or record merges without any extra synchronization.
+*/
+
+struct union_find_concurrent {
+    union_find_concurrent(uint64_t N) : N{N}, cnt{N}, ids{std::make_unique<std::atomic<uint64_t>[]>(N)} {
+        for (uint64_t i = 0; i < N; ++i)
+            ids[i].store(i, std::memory_order_relaxed);
+    }
+
+    std::string name() const {return "concurrent quick union with path halving";}
+
+    // true if this call merged the components of p and q
+    bool connect(uint64_t p, uint64_t q) {
+        while (true) {
+            p = find(p);
+            q = find(q);
+            if (p == q)
+                return false;
+            if (p > q)
+                std::swap(p, q);
+            auto expected = p;
+            if (ids[p].compare_exchange_strong(expected, q)) {
+                cnt.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+    }
+
+    uint64_t find(uint64_t p) {
+        assert(p < N);
+        while (true) {
+            auto parent = ids[p].load();
+            if (parent == p)
+                return p;
+            auto grandparent = ids[parent].load();
+            if (parent != grandparent)
+                ids[p].compare_exchange_weak(parent, grandparent);
+            p = grandparent;
+        }
+    }
+
+    // with concurrent connects: true if p and q were connected at some point during the call
+    bool connected(uint64_t p, uint64_t q) {
+        while (true) {
+            p = find(p);
+            q = find(q);
+            if (p == q)
+                return true;
+            //p still a root => they were not connected when q was found
+            if (ids[p].load() == p)
+                return false;
+        }
+    }
+
+    uint64_t count() const { return cnt.load(); }
+
+private:
+    uint64_t N;
+    std::atomic<uint64_t> cnt;
+    std::unique_ptr<std::atomic<uint64_t>[]> ids;
+};
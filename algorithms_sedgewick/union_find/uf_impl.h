@@ -3,6 +3,8 @@
 #include <iostream>
 #include <memory>
 #include <vector>
+#include <string>
+#include <numeric>
 #include <algorithm>
 #include <assert.h> 
 
@@ -134,6 +136,9 @@ struct union_find_weighted_quick_union : public virtual union_find_quick_union {
         return union_find_quick_union::find(p);
     }
 
+    // number of elements in the component of p
+    uint64_t size(uint64_t p) { return cnts[find(p)]; }
+
 protected:
     std::vector<uint64_t> cnts;
 };
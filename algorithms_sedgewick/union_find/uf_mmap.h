@@ -0,0 +1,229 @@
+#pragma once
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "uf_impl.h"
+
+// weighted quick union with path compression on a memory mapped file
+
+/*
+file layout (native endianness):
+    header      64 bytes: magic, version, complete flag, N, count, input offset, checkpoints,
+                size and hash of the input (set by the caller, so that a resume can check it is the same;
+                uf_persistent_client.cpp hashes the first and last MB only, a bounded cost)
+    ids         N x uint64
+    cnts        N x uint64
+
+Every connect writes straight into the mapping, the kernel flushes the pages when it wants to.
+A checkpoint msyncs the arrays and only then writes the header (count + how much of the input
+was consumed), so the arrays on disk are always at least as recent as the header.
+
+Resuming from a checkpoint replays the input from the saved offset: connecting two objects already
+connected does nothing, so the pairs processed after the checkpoint (whose writes may or may not
+have reached the disk) are simply applied again. The count is recomputed from the roots, O(N).
+
+Why a partially flushed file is still a valid forest: a parent pointer always points to an
+ancestor and the ancestor relation only grows (trees are merged, never split), so pointers taken
+from different moments in time can't form a cycle. The cnts may be stale, that only affects the
+balancing, not the answers.
+
+Opening a complete file read only is O(1) (map + header check): find just follows the pointers,
+without path compression, so any number of processes can share the same pages.
+*/
+
+struct union_find_mmap : public union_find {
+    static constexpr uint64_t magic = 0x50414d4d46465500ull; //"\0UFFMMAP"
+    static constexpr uint32_t version = 2;
+
+    struct header_t {
+        uint64_t magic;
+        uint32_t version;
+        uint32_t complete;
+        uint64_t N;
+        uint64_t count;
+        //how much of the input was consumed at the last checkpoint
+        uint64_t offset;
+        uint64_t checkpoints;
+        uint64_t input_size;
+        uint64_t input_hash;
+    };
+    static_assert(sizeof(header_t) == 64, "the arrays must start 8 bytes aligned");
+
+    enum class access_t {create, resume, read_only};
+
+    // create: new file for N objects (truncates an existing one)
+    // resume: reopen an existing file for writing (recounts the components)
+    // read_only: reopen an existing file for queries, O(1)
+    union_find_mmap(std::string const& path, access_t mode, uint64_t N = 0) : union_find(0), path{path}, mode{mode} {
+        if (mode == access_t::create) {
+            file.fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+            if (file.fd < 0) fail("open");
+            if (::ftruncate(file.fd, off_t(file_size(N))) != 0) fail("ftruncate");
+            map(file_size(N));
+
+            *hdr = header_t{magic, version, 0, N, N, 0, 0, 0, 0};
+            for (uint64_t i = 0; i < N; ++i) {
+                parent[i] = i;
+                cnts[i] = 1;
+            }
+            cnt = N;
+            return;
+        }
+
+        file.fd = ::open(path.c_str(), mode == access_t::read_only ? O_RDONLY : O_RDWR);
+        if (file.fd < 0) fail("open");
+        struct stat sb;
+        if (::fstat(file.fd, &sb) != 0) fail("fstat");
+        if (uint64_t(sb.st_size) < sizeof(header_t)) invalid("file too small");
+        map(uint64_t(sb.st_size));
+
+        if (hdr->magic != magic) invalid("not a union find file");
+        if (hdr->version != version) invalid("unsupported version " + std::to_string(hdr->version));
+        if (file_size(hdr->N) != mapping.bytes) invalid("size does not match N");
+        if (mode == access_t::read_only && !hdr->complete) invalid("incomplete, resume it first");
+
+        cnt = hdr->count;
+        if (mode == access_t::resume) {
+            //the arrays may be ahead of the header
+            cnt = 0;
+            for (uint64_t i = 0; i < hdr->N; ++i)
+                cnt += parent[i] == i;
+            hdr->complete = 0;
+        }
+    }
+
+    union_find_mmap(union_find_mmap const&) = delete;
+    union_find_mmap& operator=(union_find_mmap const&) = delete;
+
+    std::string name() const override {return "weighted quick union with path compression (mmap)";}
+
+    void connect(uint64_t p, uint64_t q) override {
+        if (mode == access_t::read_only)
+            throw std::logic_error("connect on a read only union find");
+
+        auto idp = find(p);
+        auto idq = find(q);
+
+        if (idp == idq)
+            return;
+
+        if (cnts[idp] < cnts[idq]) {
+            parent[idp] = idq;
+            cnts[idq] += cnts[idp];
+        } else {
+            parent[idq] = idp;
+            cnts[idp] += cnts[idq];
+        }
+
+        cnt--;
+    }
+
+    uint64_t find(uint64_t p) override {
+        check(p);
+        if (mode == access_t::read_only) {
+            while (p != parent[p])
+                p = parent[p];
+            return p;
+        }
+        while (p != parent[p]) {
+            parent[p] = parent[parent[p]];
+            p = parent[p];
+        }
+        return p;
+    }
+
+    // number of elements in the component of p
+    uint64_t size(uint64_t p) { return cnts[find(p)]; }
+
+    // makes the state durable and records how much of the input it covers
+    void checkpoint(uint64_t offset) {
+        if (mode == access_t::read_only)
+            throw std::logic_error("checkpoint on a read only union find");
+        if (::msync(mapping.mem, mapping.bytes, MS_SYNC) != 0) fail("msync");
+        hdr->count = cnt;
+        hdr->offset = offset;
+        hdr->checkpoints++;
+        if (::msync(mapping.mem, sizeof(header_t), MS_SYNC) != 0) fail("msync");
+    }
+
+    // last checkpoint + the flag that allows read only opens
+    void finish(uint64_t offset) {
+        checkpoint(offset);
+        hdr->complete = 1;
+        if (::msync(mapping.mem, sizeof(header_t), MS_SYNC) != 0) fail("msync");
+    }
+
+    uint64_t objects() const { return hdr->N; }
+    uint64_t offset() const { return hdr->offset; }
+    uint64_t checkpoints() const { return hdr->checkpoints; }
+    bool complete() const { return hdr->complete != 0; }
+
+    // what the state was built from (e.g. size and hash of the input file), durable at the next checkpoint
+    void identify(uint64_t input_size, uint64_t input_hash) {
+        if (mode == access_t::read_only)
+            throw std::logic_error("identify on a read only union find");
+        hdr->input_size = input_size;
+        hdr->input_hash = input_hash;
+    }
+    uint64_t input_size() const { return hdr->input_size; }
+    uint64_t input_hash() const { return hdr->input_hash; }
+
+    static uint64_t file_size(uint64_t N) { return sizeof(header_t) + 2 * N * sizeof(uint64_t); }
+
+private:
+    void map(uint64_t size) {
+        int prot = mode == access_t::read_only ? PROT_READ : PROT_READ | PROT_WRITE;
+        mapping.mem = ::mmap(nullptr, size, prot, MAP_SHARED, file.fd, 0);
+        if (mapping.mem == MAP_FAILED) fail("mmap");
+        mapping.bytes = size;
+        hdr = static_cast<header_t*>(mapping.mem);
+        parent = reinterpret_cast<uint64_t*>(hdr + 1);
+        cnts = parent + (size - sizeof(header_t)) / (2 * sizeof(uint64_t));
+    }
+
+    void check(uint64_t p) const {
+        if (p >= hdr->N)
+            throw std::out_of_range("object " + std::to_string(p) + " out of range");
+    }
+
+    [[noreturn]] void fail(std::string const& what) const {
+        throw std::runtime_error(what + " " + path + ": " + std::strerror(errno));
+    }
+
+    [[noreturn]] void invalid(std::string const& what) const {
+        throw std::runtime_error(path + ": " + what);
+    }
+
+    //the descriptor and the mapping are released by members, so that they are also released when
+    //the constructor throws (the destructor of the object does not run then)
+    struct file_t {
+        ~file_t() { if (fd >= 0) ::close(fd); }
+        int fd{-1};
+    };
+    struct mapping_t {
+        ~mapping_t() { if (mem != MAP_FAILED) ::munmap(mem, bytes); }
+        void* mem{MAP_FAILED};
+        uint64_t bytes{0};
+    };
+
+    std::string path;
+    access_t mode;
+    //(unmapped before the file is closed)
+    file_t file;
+    mapping_t mapping;
+    header_t* hdr{nullptr};
+    //the ids of the base class are not used
+    uint64_t* parent{nullptr};
+    uint64_t* cnts{nullptr};
+};
+
+constexpr uint64_t union_find_mmap::magic;
+constexpr uint32_t union_find_mmap::version;
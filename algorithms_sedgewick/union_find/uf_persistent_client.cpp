@@ -0,0 +1,227 @@
+/*
+to compile (e.g.): g++ -std=c++14 uf_persistent_client.cpp -O3
+to run (e.g.):
+    ./a.out ingest state.uf datasets/mediumUF.txt [every]
+        builds (or resumes, if state.uf is an incomplete file) the union find of the input,
+        with a checkpoint every `every` pairs (default 1000000); a resume checks that the input
+        has the same size and the same first and last MB (hash) as the one the file was built from
+    ./a.out query state.uf < pairs.txt
+        read only queries on a complete file, prints "p q -> connected | not connected"
+    ./a.out bench datasets/largeUF.txt state.uf
+        checkpoint overhead (in memory vs mmap with checkpoints every 10^6, 10^5, 10^4 pairs)
+        and restart time (a child process is stopped half way, without its final checkpoint, then resumed)
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <sys/wait.h>
+
+#include "uf_mmap.h"
+
+template<typename F>
+double time_it(F&& f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+bool exists(std::string const& path) {
+    struct stat sb;
+    return ::stat(path.c_str(), &sb) == 0;
+}
+
+// size of a file and FNV-1a hash of its first and last MB: a bounded cost on every create / resume,
+// enough to tell another input (or one that was appended to or truncated) from the right one
+std::pair<uint64_t, uint64_t> fingerprint(std::string const& path) {
+    std::ifstream is{path, std::ios::binary};
+    if (!is)
+        throw std::runtime_error("cannot open " + path);
+    is.seekg(0, std::ios::end);
+    uint64_t size = uint64_t(is.tellg()), sample = 1 << 20;
+    uint64_t hash = 0xcbf29ce484222325ull;
+    std::vector<char> buffer(sample);
+    for (uint64_t from : {uint64_t(0), size > 2*sample ? size - sample : sample}) {
+        uint64_t n = std::min(sample, size > from ? size - from : 0);
+        is.seekg(std::streamoff(from));
+        if (!n || !is.read(buffer.data(), std::streamsize(n)))
+            continue;
+        for (uint64_t i = 0; i < n; ++i) {
+            hash ^= uint8_t(buffer[i]);
+            hash *= 0x100000001b3ull;
+        }
+    }
+    return {size, hash};
+}
+
+struct ingest_stats_t {
+    bool resumed{false};
+    uint64_t offset{0};
+    uint64_t pairs{0};
+    uint64_t checkpoints{0};
+    uint64_t count{0};
+    double open_time{0};
+    double time{0};
+};
+
+// every = 0: only the final checkpoint
+// stop > 0: returns after `stop` pairs without checkpointing nor finishing (a crash, as seen by the file)
+ingest_stats_t ingest(std::string const& state, std::string const& input, uint64_t every, uint64_t stop = 0) {
+    ingest_stats_t st;
+    auto start = std::chrono::steady_clock::now();
+
+    std::ifstream is{input};
+    if (!is)
+        throw std::runtime_error("cannot open " + input);
+    uint64_t N = 0;
+    is >> N;
+
+    std::unique_ptr<union_find_mmap> uf;
+    st.open_time = time_it([&] {
+        auto id = fingerprint(input);
+        if (exists(state)) {
+            uf = std::make_unique<union_find_mmap>(state, union_find_mmap::access_t::resume);
+            if (uf->objects() != N || uf->input_size() != id.first || uf->input_hash() != id.second)
+                throw std::runtime_error(state + " was built for another input");
+            st.resumed = true;
+            st.offset = uf->offset();
+            //0 = nothing consumed yet, the first line (N) was just read
+            if (st.offset)
+                is.seekg(std::streamoff(st.offset));
+        } else {
+            uf = std::make_unique<union_find_mmap>(state, union_find_mmap::access_t::create, N);
+            uf->identify(id.first, id.second);
+        }
+    });
+
+    uint64_t p, q;
+    while (is >> p >> q) {
+        uf->connect(p, q);
+        ++st.pairs;
+        if (stop && st.pairs == stop)
+            return st;
+        if (every && st.pairs % every == 0)
+            uf->checkpoint(uint64_t(is.tellg()));
+    }
+    if (!is.eof())
+        throw std::runtime_error("invalid input in " + input);
+
+    is.clear();
+    is.seekg(0, std::ios::end);
+    uf->finish(uint64_t(is.tellg()));
+
+    st.checkpoints = uf->checkpoints();
+    st.count = uf->count();
+    st.time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return st;
+}
+
+int bench(std::string const& input, std::string const& state) {
+    //reference: the in memory version
+    uint64_t N = 0, pairs = 0, count = 0;
+    double t_mem = time_it([&] {
+        std::ifstream is{input};
+        is >> N;
+        union_find_weighted_quick_union_path_compression uf{N};
+        uint64_t p, q;
+        while (is >> p >> q) {
+            uf.connect(p, q);
+            ++pairs;
+        }
+        count = uf.count();
+    });
+    std::cout << "objects: " << N << ", pairs: " << pairs << ", connected components: " << count << std::endl
+              << std::fixed << std::setprecision(3)
+              << std::left << std::setw(28) << "in memory" << t_mem << "s" << std::endl;
+
+    bool ok = true;
+    double t_base = 0;
+    for (uint64_t every : {uint64_t(0), uint64_t(1000000), uint64_t(100000), uint64_t(10000)}) {
+        std::remove(state.c_str());
+        auto st = ingest(state, input, every);
+        ok = ok && st.count == count;
+        if (!every) t_base = st.time;
+        std::cout << std::setw(28) << (every ? "mmap, every " + std::to_string(every) : std::string("mmap, final checkpoint only"))
+                  << st.time << "s (" << st.checkpoints << " checkpoints, +"
+                  << std::setprecision(1) << 100 * (st.time - t_base) / t_base << "% vs final only)"
+                  << std::setprecision(3) << std::endl;
+    }
+
+    //restart: the child stops half way, without its final checkpoint
+    std::remove(state.c_str());
+    uint64_t every = 100000;
+    pid_t pid = ::fork();
+    if (pid < 0)
+        throw std::runtime_error("fork failed");
+    if (pid == 0) {
+        ingest(state, input, every, pairs / 2);
+        ::_exit(EXIT_SUCCESS);
+    }
+    int status = 0;
+    ::waitpid(pid, &status, 0);
+
+    auto st = ingest(state, input, every);
+    ok = ok && st.resumed && st.count == count;
+    std::cout << "restart after a crash at pair " << pairs / 2 << " (checkpoint every " << every << "):" << std::endl
+              << "    reopen + recount          " << st.open_time << "s" << std::endl
+              << "    replayed pairs            " << st.pairs << std::endl
+              << "    total                     " << st.time << "s" << std::endl;
+
+    double t_open = time_it([&] {
+        union_find_mmap uf{state, union_find_mmap::access_t::read_only};
+        ok = ok && uf.count() == count;
+    });
+    std::cout << std::setw(28) << "read only reopen" << std::setprecision(6) << t_open << "s" << std::endl
+              << (ok ? "same results as in memory" : "MISMATCH") << std::endl;
+
+    std::remove(state.c_str());
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int main(int argc, char** argv){
+    std::string cmd = argc > 1 ? argv[1] : "";
+
+    try {
+        if (cmd == "ingest" && (argc == 4 || argc == 5)) {
+            uint64_t every = argc == 5 ? std::stoull(argv[4]) : 1000000;
+            auto st = ingest(argv[2], argv[3], every);
+            if (st.resumed)
+                std::cout << "resumed at offset " << st.offset << " (reopen: " << st.open_time << "s)" << std::endl;
+            std::cout << "pairs: " << st.pairs << ", checkpoints: " << st.checkpoints << std::endl
+                      << "connected components: " << st.count << std::endl
+                      << "algo: " << union_find_mmap{argv[2], union_find_mmap::access_t::read_only}.name() << std::endl;
+            return EXIT_SUCCESS;
+        }
+
+        if (cmd == "query" && argc == 3) {
+            union_find_mmap uf{argv[2], union_find_mmap::access_t::read_only};
+            uint64_t p, q;
+            while (std::cin >> p >> q)
+                std::cout << p << " " << q << " -> " << (uf.connected(p, q) ? "connected" : "not connected") << '\n';
+            return EXIT_SUCCESS;
+        }
+
+        if (cmd == "bench" && argc == 4)
+            return bench(argv[2], argv[3]);
+    } catch (std::exception const& e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cerr << "invalid arguments" << std::endl;
+    return EXIT_FAILURE;
+}
+
+/*
+results:
+tinyUF      ->  2 connected components
+mediumUF    ->  3 connected components
+*/
@@ -0,0 +1,215 @@
+#pragma once
+
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <immintrin.h>
+
+#include "uf_impl.h"
+
+// quick find with explicitly vectorized kernels over 32 bit ids
+
+/*
+quick find is still the best choice for small N and query heavy workloads (find = one load),
+its cost is the O(N) relabel in connect. Here the ids are 32 bits (twice as many per vector)
+and both the relabel and a batched connected (many pairs per call) are written with intrinsics.
+
+The kernel is selected at runtime (the best the cpu supports), or forced for testing/benchmarks:
+    scalar      plain loops
+    sse4.2      4 ids per instruction, compare + blend
+    avx2        8 ids per instruction, compare + blend, gathers for the batched connected
+    avx512      16 ids per instruction, compare into a mask + masked move, gathers
+*/
+
+enum class isa_t {scalar, sse42, avx2, avx512};
+
+namespace qf_kernels {
+    //ids[i] = (ids[i] == from ? to : ids[i])
+    void relabel_scalar(uint32_t* ids, uint64_t n, uint32_t from, uint32_t to) {
+        for (uint64_t i = 0; i < n; ++i)
+            if (ids[i] == from) ids[i] = to;
+    }
+
+    //out[i] = ids[p[i]] == ids[q[i]]
+    void connected_scalar(uint32_t const* ids, uint32_t const* p, uint32_t const* q, uint64_t n, uint8_t* out) {
+        for (uint64_t i = 0; i < n; ++i)
+            out[i] = ids[p[i]] == ids[q[i]];
+    }
+
+    __attribute__((target("sse4.2")))
+    void relabel_sse42(uint32_t* ids, uint64_t n, uint32_t from, uint32_t to) {
+        auto vfrom = _mm_set1_epi32(int(from)), vto = _mm_set1_epi32(int(to));
+        uint64_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            auto v = _mm_loadu_si128(reinterpret_cast<__m128i const*>(ids + i));
+            auto m = _mm_cmpeq_epi32(v, vfrom);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(ids + i), _mm_blendv_epi8(v, vto, m));
+        }
+        relabel_scalar(ids + i, n - i, from, to);
+    }
+
+    //no gather before avx2: the loads are scalar, only the compare is vectorized
+    __attribute__((target("sse4.2")))
+    void connected_sse42(uint32_t const* ids, uint32_t const* p, uint32_t const* q, uint64_t n, uint8_t* out) {
+        uint64_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            auto a = _mm_set_epi32(int(ids[p[i+3]]), int(ids[p[i+2]]), int(ids[p[i+1]]), int(ids[p[i]]));
+            auto b = _mm_set_epi32(int(ids[q[i+3]]), int(ids[q[i+2]]), int(ids[q[i+1]]), int(ids[q[i]]));
+            int m = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(a, b)));
+            for (int j = 0; j < 4; ++j) out[i+j] = (m >> j) & 1;
+        }
+        connected_scalar(ids, p + i, q + i, n - i, out + i);
+    }
+
+    __attribute__((target("avx2")))
+    void relabel_avx2(uint32_t* ids, uint64_t n, uint32_t from, uint32_t to) {
+        auto vfrom = _mm256_set1_epi32(int(from)), vto = _mm256_set1_epi32(int(to));
+        uint64_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            auto v = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(ids + i));
+            auto m = _mm256_cmpeq_epi32(v, vfrom);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(ids + i), _mm256_blendv_epi8(v, vto, m));
+        }
+        relabel_scalar(ids + i, n - i, from, to);
+    }
+
+    __attribute__((target("avx2,bmi2")))
+    void connected_avx2(uint32_t const* ids, uint32_t const* p, uint32_t const* q, uint64_t n, uint8_t* out) {
+        auto base = reinterpret_cast<int const*>(ids);
+        uint64_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            auto vp = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(p + i));
+            auto vq = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(q + i));
+            auto a = _mm256_i32gather_epi32(base, vp, 4);
+            auto b = _mm256_i32gather_epi32(base, vq, 4);
+            int m = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(a, b)));
+            //one bit per pair -> one byte per pair
+            uint64_t bytes = _pdep_u64(uint64_t(m), 0x0101010101010101ull);
+            std::memcpy(out + i, &bytes, 8);
+        }
+        connected_scalar(ids, p + i, q + i, n - i, out + i);
+    }
+
+    __attribute__((target("avx512f")))
+    void relabel_avx512(uint32_t* ids, uint64_t n, uint32_t from, uint32_t to) {
+        auto vfrom = _mm512_set1_epi32(int(from)), vto = _mm512_set1_epi32(int(to));
+        uint64_t i = 0;
+        for (; i + 16 <= n; i += 16) {
+            auto v = _mm512_loadu_si512(ids + i);
+            auto m = _mm512_cmpeq_epi32_mask(v, vfrom);
+            if (m) _mm512_mask_storeu_epi32(ids + i, m, vto);
+        }
+        relabel_scalar(ids + i, n - i, from, to);
+    }
+
+    __attribute__((target("avx512f,bmi2")))
+    void connected_avx512(uint32_t const* ids, uint32_t const* p, uint32_t const* q, uint64_t n, uint8_t* out) {
+        uint64_t i = 0;
+        for (; i + 16 <= n; i += 16) {
+            auto vp = _mm512_loadu_si512(p + i);
+            auto vq = _mm512_loadu_si512(q + i);
+            auto a = _mm512_mask_i32gather_epi32(_mm512_setzero_si512(), 0xffff, vp, ids, 4);
+            auto b = _mm512_mask_i32gather_epi32(_mm512_setzero_si512(), 0xffff, vq, ids, 4);
+            uint64_t m = _mm512_cmpeq_epi32_mask(a, b);
+            uint64_t lo = _pdep_u64(m & 0xff, 0x0101010101010101ull);
+            uint64_t hi = _pdep_u64(m >> 8, 0x0101010101010101ull);
+            std::memcpy(out + i, &lo, 8);
+            std::memcpy(out + i + 8, &hi, 8);
+        }
+        connected_scalar(ids, p + i, q + i, n - i, out + i);
+    }
+
+    bool supported(isa_t isa) {
+        __builtin_cpu_init();
+        switch (isa) {
+            case isa_t::scalar: return true;
+            case isa_t::sse42: return __builtin_cpu_supports("sse4.2");
+            case isa_t::avx2: return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("bmi2");
+            case isa_t::avx512: return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("bmi2");
+        }
+        return false;
+    }
+
+    using relabel_fn = void (*)(uint32_t*, uint64_t, uint32_t, uint32_t);
+    using connected_fn = void (*)(uint32_t const*, uint32_t const*, uint32_t const*, uint64_t, uint8_t*);
+
+    relabel_fn relabel_kernel(isa_t isa) {
+        switch (isa) {
+            case isa_t::sse42: return relabel_sse42;
+            case isa_t::avx2: return relabel_avx2;
+            case isa_t::avx512: return relabel_avx512;
+            default: return relabel_scalar;
+        }
+    }
+
+    connected_fn connected_kernel(isa_t isa) {
+        switch (isa) {
+            case isa_t::sse42: return connected_sse42;
+            case isa_t::avx2: return connected_avx2;
+            case isa_t::avx512: return connected_avx512;
+            default: return connected_scalar;
+        }
+    }
+
+    isa_t best() {
+        for (auto isa : {isa_t::avx512, isa_t::avx2, isa_t::sse42})
+            if (supported(isa)) return isa;
+        return isa_t::scalar;
+    }
+
+    std::string name(isa_t isa) {
+        switch (isa) {
+            case isa_t::scalar: return "scalar";
+            case isa_t::sse42: return "sse4.2";
+            case isa_t::avx2: return "avx2";
+            case isa_t::avx512: return "avx512";
+        }
+        return "?";
+    }
+}
+
+// quick find (eager approach) on 32 bit ids with simd kernels
+
+struct union_find_quick_find_simd : public union_find {
+    //the 64 bit ids of the base class are not used
+    union_find_quick_find_simd(uint64_t N, isa_t isa = qf_kernels::best())
+        : union_find(0), isa{isa}, relabel{qf_kernels::relabel_kernel(isa)}, batch{qf_kernels::connected_kernel(isa)}
+    {
+        assert(N <= uint64_t(std::numeric_limits<int32_t>::max()));
+        assert(qf_kernels::supported(isa));
+        cnt = N;
+        ids32.resize(N);
+        std::iota(ids32.begin(), ids32.end(), 0);
+    }
+
+    std::string name() const override {return "quick find (" + qf_kernels::name(isa) + ")";}
+
+    void connect(uint64_t p, uint64_t q) override {
+        auto idp = uint32_t(find(p));
+        auto idq = uint32_t(find(q));
+
+        if (idp == idq)
+            return;
+
+        relabel(ids32.data(), ids32.size(), idp, idq);
+        cnt--;
+    }
+
+    uint64_t find(uint64_t p) override { return ids32.at(p); }
+
+    //out[i] = connected(p[i], q[i]) for n pairs (p[i], q[i] < N, not checked)
+    void connected(uint32_t const* p, uint32_t const* q, uint64_t n, uint8_t* out) const {
+        batch(ids32.data(), p, q, n, out);
+    }
+    using union_find::connected;
+
+    std::vector<uint32_t> const& labels() const { return ids32; }
+
+private:
+    isa_t isa;
+    qf_kernels::relabel_fn relabel;
+    qf_kernels::connected_fn batch;
+    std::vector<uint32_t> ids32;
+};
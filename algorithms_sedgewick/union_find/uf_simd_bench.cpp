@@ -0,0 +1,104 @@
+/*
+to compile (e.g.): g++ -std=c++14 uf_simd_bench.cpp -O3
+to run (e.g.): ./a.out [N]
+    N: number of objects (default 4096)
+
+for every kernel the cpu supports:
+    - checks that it gives the same results as the scalar one (random connects + batched connected)
+    - measures the relabel kernel throughput (ids/s) and the batched connected throughput (pairs/s)
+*/
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <random>
+#include <string>
+
+#include "uf_simd.h"
+
+template<typename F>
+double time_it(F&& f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// same random operations on the scalar version and on the isa version
+bool check(uint64_t N, isa_t isa) {
+    union_find_quick_find_simd ref{N, isa_t::scalar}, uf{N, isa};
+    std::mt19937_64 gen{7};
+    std::uniform_int_distribution<uint32_t> pick{0, uint32_t(N - 1)};
+
+    std::vector<uint32_t> p, q;
+    std::vector<uint8_t> a, b;
+    for (uint64_t round = 0; round < 64; ++round) {
+        //each connect is a full pass over the ids, keep it bounded for large N
+        for (uint64_t i = 0; i < std::min<uint64_t>(N / 64 + 1, 16); ++i) {
+            auto x = pick(gen), y = pick(gen);
+            ref.connect(x, y);
+            uf.connect(x, y);
+        }
+        if (ref.labels() != uf.labels() || ref.count() != uf.count())
+            return false;
+
+        //odd sizes to go through the scalar tails too
+        uint64_t n = 1 + round * 37;
+        p.resize(n); q.resize(n); a.resize(n); b.resize(n);
+        for (uint64_t i = 0; i < n; ++i) { p[i] = pick(gen); q[i] = pick(gen); }
+        ref.connected(p.data(), q.data(), n, a.data());
+        uf.connected(p.data(), q.data(), n, b.data());
+        if (a != b)
+            return false;
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    uint64_t N = argc > 1 ? std::stoull(argv[1]) : 4096;
+    std::cout << "number of objects: " << N << std::endl;
+
+    bool ok = true;
+    std::cout << std::left << std::setw(8) << "isa" << std::setw(8) << "check"
+              << std::setw(20) << "relabel (Gids/s)" << "connected (Mpairs/s)" << std::endl;
+
+    for (auto isa : {isa_t::scalar, isa_t::sse42, isa_t::avx2, isa_t::avx512}) {
+        if (!qf_kernels::supported(isa)) {
+            std::cout << std::setw(8) << qf_kernels::name(isa) << "not supported" << std::endl;
+            continue;
+        }
+        bool same = check(N, isa);
+        ok = ok && same;
+
+        std::mt19937_64 gen{11};
+        std::uniform_int_distribution<uint32_t> pick{0, uint32_t(N - 1)};
+
+        //relabel: the kernel of connect, over ids holding 64 different labels
+        auto relabel = qf_kernels::relabel_kernel(isa);
+        std::vector<uint32_t> ids(N);
+        for (auto& id : ids) id = pick(gen) % 64;
+        uint64_t passes = std::max<uint64_t>(1, (uint64_t(1) << 30) / N);
+        double t_relabel = time_it([&] {
+            for (uint64_t r = 0; r < passes; ++r)
+                relabel(ids.data(), N, uint32_t(r % 64), uint32_t((r + 1) % 64));
+        });
+
+        //batched connected over 1M random pairs, repeated
+        union_find_quick_find_simd uf{N, isa};
+        for (uint64_t i = 0; i < std::min<uint64_t>(N / 2, 1024); ++i)
+            uf.connect(pick(gen), pick(gen));
+        uint64_t n = 1 << 20, reps = 16;
+        std::vector<uint32_t> p(n), q(n);
+        std::vector<uint8_t> out(n);
+        for (uint64_t i = 0; i < n; ++i) { p[i] = pick(gen); q[i] = pick(gen); }
+        double t_connected = time_it([&] {
+            for (uint64_t r = 0; r < reps; ++r)
+                uf.connected(p.data(), q.data(), n, out.data());
+        });
+
+        std::cout << std::setw(8) << qf_kernels::name(isa) << std::setw(8) << (same ? "ok" : "FAILED")
+                  << std::setw(20) << std::fixed << std::setprecision(2) << double(passes) * N / t_relabel / 1e9
+                  << double(n) * reps / t_connected / 1e6 << std::endl;
+    }
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -6,6 +6,10 @@
 #include <functional>
 
 #include "uf_impl.h"
+//the simd quick find is x86 only (intrinsics and runtime cpu detection)
+#if defined(__x86_64__) || defined(__i386__)
+#include "uf_simd.h"
+#endif
 
 std::string default_algo = "wqupc";
 
@@ -13,6 +17,9 @@ std::string default_algo = "wqupc";
 std::unique_ptr<union_find> build_algorithm(uint64_t N, std::string const& algo_name){
     static std::map<std::string, std::function<std::unique_ptr<union_find>(uint64_t)>> str_to_algo = {
             std::make_pair(std::string("qf"), [](uint64_t N){return std::make_unique<union_find_quick_find>(N);})
+#if defined(__x86_64__) || defined(__i386__)
+        ,   std::make_pair(std::string("qfsimd"), [](uint64_t N){return std::make_unique<union_find_quick_find_simd>(N);})
+#endif
         ,   std::make_pair(std::string("qu"), [](uint64_t N){return std::make_unique<union_find_quick_union>(N);})
         ,   std::make_pair(std::string("wqu"), [](uint64_t N){return std::make_unique<union_find_weighted_quick_union>(N);})
         ,   std::make_pair(std::string("qupc"), [](uint64_t N){return std::make_unique<union_find_quick_union_path_compression>(N);})